@@ -0,0 +1,55 @@
+/*
+ * Utilitários comuns aos benchmarks
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "cycles.h"
+#include "bench.h"
+
+/** @brief Ciclos de CPU acumulados pela thread corrente */
+static uint64_t bench_cpu_cycles(void)
+{
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+	k_thread_runtime_stats_t stats;
+
+	/* Usage is only accounted on a context switch, force one so the current slice is included */
+	k_sleep(K_TICKS(1));
+	if (k_thread_runtime_stats_get(k_current_get(), &stats) == 0) {
+		return stats.execution_cycles;
+	}
+#endif
+	return 0;
+}
+
+void bench_begin(struct bench_clock *c)
+{
+	c->cpu_start = bench_cpu_cycles();
+	c->wall_start = cycles_now();
+}
+
+void bench_end(struct bench_clock *c)
+{
+	c->wall = cycles_now() - c->wall_start;
+	c->cpu = bench_cpu_cycles() - c->cpu_start;
+}
+
+void bench_header(const char *title)
+{
+	printk("\n\r%s\n\r", title);
+	printk("%-28s %6s %12s %12s %12s\n\r", "variant", "param",
+	       "cpu cyc/smp", "wall cyc/smp", "wall ns/smp");
+}
+
+void bench_row(const char *name, uint32_t param, const struct bench_clock *c, uint32_t samples)
+{
+	if (samples == 0) {
+		printk("%-28s %6u %12s\n\r", name, param, "n/a");
+		return;
+	}
+
+	printk("%-28s %6u %12u %12u %12u\n\r", name, param,
+	       (uint32_t)(c->cpu / samples), c->wall / samples,
+	       (uint32_t)(cycles_to_ns(c->wall) / samples));
+}
@@ -0,0 +1,63 @@
+/*
+ * Utilitários comuns aos benchmarks
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <zephyr.h>
+
+/** @brief Medição de um troço de código */
+struct bench_clock {
+	uint32_t wall_start;	/**< Contador de ciclos no início */
+	uint64_t cpu_start;	/**< Ciclos de CPU da thread no início */
+	uint32_t wall;		/**< Ciclos decorridos */
+	uint64_t cpu;		/**< Ciclos de CPU gastos pela thread (0 sem CONFIG_THREAD_RUNTIME_STATS) */
+};
+
+/** @brief Inicia uma medição */
+void bench_begin(struct bench_clock *c);
+
+/** @brief Termina uma medição iniciada com bench_begin() */
+void bench_end(struct bench_clock *c);
+
+/** @brief Imprime o título e o cabeçalho de uma tabela de resultados */
+void bench_header(const char *title);
+
+/** @brief Imprime uma linha da tabela de resultados
+ *
+ * @param name Variante medida.
+ * @param param Parâmetro da variante (janela, 2^N, ...).
+ * @param c Medição.
+ * @param samples Amostras entregues durante a medição.
+ */
+void bench_row(const char *name, uint32_t param, const struct bench_clock *c, uint32_t samples);
+
+/** @brief ADC: sobreamostragem em hardware vs média em software */
+void bench_oversampling(void);
+
+/** @brief Conversão raw -> mV em vírgula flutuante vs vírgula fixa */
+void bench_conversion(void);
+
+/** @brief Filtro: núcleo original vs média aparada numa só passagem */
+void bench_trimmed_mean(void);
+
+/** @brief Biblioteca de filtros: ciclos por amostra de cada núcleo */
+void bench_filters(void);
+
+/** @brief Mediana: cópia ordenada vs skiplist indexável em janelas grandes */
+void bench_median(void);
+
+/** @brief FIR/biquad: por amostra vs por blocos (C genérico e CMSIS-DSP) */
+void bench_dsp(void);
+
+/** @brief Transportes do pipeline: latência e débito de cada primitiva */
+void bench_transport(void);
+
+/** @brief Execução do pipeline: três threads vs work queue run-to-completion */
+void bench_exec(void);
+
+/** @brief Pipeline: período mínimo sustentável da thread_ADC para o transporte e o logging escolhidos */
+void bench_sweep(void);
+
+#endif /* BENCH_H */
@@ -0,0 +1,61 @@
+/*
+ * Conversão raw -> mV: vírgula flutuante vs vírgula fixa
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "adc_conv.h"
+#include "bench.h"
+
+#define CONV_BLOCK 256 /**< Amostras convertidas por bloco */
+
+static uint16_t raw[CONV_BLOCK];
+static volatile uint16_t mv[CONV_BLOCK]; /* volatile: keep the compiler from dropping the loops */
+
+/** @brief Conversão original da thread_ADC_code */
+static uint16_t float_raw_to_mv(uint16_t sample)
+{
+	return (uint16_t)(1000*sample*((float)3/ADC_RAW_MAX));
+}
+
+void bench_conversion(void)
+{
+	struct bench_clock clk;
+	uint32_t blocks = DIV_ROUND_UP(CONFIG_BENCH_ITERATIONS, CONV_BLOCK);
+	int max_diff = 0;
+
+	/* Ramp over the whole input range */
+	for (int i = 0; i < CONV_BLOCK; i++) {
+		raw[i] = (uint32_t)i * ADC_RAW_MAX / (CONV_BLOCK - 1);
+	}
+
+	for (uint32_t v = 0; v <= ADC_RAW_MAX; v++) {
+		int diff = (int)adc_raw_to_mv(v) - float_raw_to_mv(v);
+
+		max_diff = MAX(max_diff, diff < 0 ? -diff : diff);
+	}
+
+	bench_header("raw -> mV conversion");
+
+	bench_begin(&clk);
+	for (uint32_t b = 0; b < blocks; b++) {
+		for (int i = 0; i < CONV_BLOCK; i++) {
+			mv[i] = float_raw_to_mv(raw[i]);
+		}
+	}
+	bench_end(&clk);
+	bench_row("float (original)", ADC_RESOLUTION, &clk, blocks * CONV_BLOCK);
+
+	bench_begin(&clk);
+	for (uint32_t b = 0; b < blocks; b++) {
+		for (int i = 0; i < CONV_BLOCK; i++) {
+			mv[i] = adc_raw_to_mv(raw[i]);
+		}
+	}
+	bench_end(&clk);
+	bench_row("fixed point adc_raw_to_mv", ADC_RESOLUTION, &clk, blocks * CONV_BLOCK);
+
+	/* The original truncates, the fixed point path rounds: up to 1 mV apart */
+	printk("max |fixed - float| over 0..%u: %d mV\n\r", (unsigned int)ADC_RAW_MAX, max_diff);
+}
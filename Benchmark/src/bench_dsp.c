@@ -0,0 +1,153 @@
+/*
+ * FIR/biquad: por amostra vs por blocos (C genérico e CMSIS-DSP)
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+
+#include "fir.h"
+#include "biquad.h"
+#include "dsp_filter.h"
+#include "bench.h"
+
+#define MAX_TAPS 64 /**< Maior FIR medido */
+#define MAX_BLOCK 64 /**< Maior bloco medido */
+
+static const uint16_t taps[] = { 16, 64 };
+static const uint16_t blocks[] = { 1, 16, 64 };
+
+static q15_t trace[CONFIG_BENCH_ITERATIONS];
+static q15_t out_c[CONFIG_BENCH_ITERATIONS];
+static q15_t out_dsp[CONFIG_BENCH_ITERATIONS];
+static q15_t coeffs[MAX_TAPS];
+static q15_t state[DSP_FIR_STATE_LEN(MAX_TAPS, MAX_BLOCK)];
+static uint16_t window[FIR_BUF_LEN(MAX_TAPS)];
+static volatile uint16_t out; /* keep the compiler from dropping the loops */
+
+/** @brief Amostras que cabem num número inteiro de blocos */
+static uint32_t whole_blocks(uint16_t block)
+{
+	return CONFIG_BENCH_ITERATIONS / block * block;
+}
+
+static void bench_dsp_fir(uint16_t ntaps)
+{
+	struct bench_clock clk;
+	struct fir fir;
+	struct dsp_fir dsp;
+	char name[32];
+
+	/* Same taps for the sample by sample FIR, which takes them newest first */
+	dsp_fir_triangular(coeffs, ntaps);
+	fir_init(&fir, window, ntaps);
+	for (int k = 0; k < ntaps / 2; k++) {
+		q15_t t = coeffs[k];
+
+		coeffs[k] = coeffs[ntaps - 1 - k];
+		coeffs[ntaps - 1 - k] = t;
+	}
+	fir_set_coeffs(&fir, coeffs);
+
+	bench_begin(&clk);
+	for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+		fir_push(&fir, trace[i]);
+		out = fir_output(&fir);
+	}
+	bench_end(&clk);
+	bench_row("fir, per sample", ntaps, &clk, CONFIG_BENCH_ITERATIONS);
+
+	dsp_fir_triangular(coeffs, ntaps);
+	for (int b = 0; b < ARRAY_SIZE(blocks); b++) {
+		uint32_t n = whole_blocks(blocks[b]);
+
+		dsp_fir_init(&dsp, coeffs, ntaps, state, blocks[b]);
+		bench_begin(&clk);
+		for (uint32_t i = 0; i < n; i += blocks[b]) {
+			dsp_fir_process_c(&dsp, &trace[i], &out_c[i], blocks[b]);
+		}
+		bench_end(&clk);
+		snprintk(name, sizeof(name), "dsp_fir C, block %u", blocks[b]);
+		bench_row(name, ntaps, &clk, n);
+
+#if defined(CONFIG_CMSIS_DSP)
+		dsp_fir_init(&dsp, coeffs, ntaps, state, blocks[b]);
+		bench_begin(&clk);
+		for (uint32_t i = 0; i < n; i += blocks[b]) {
+			dsp_fir_process(&dsp, &trace[i], &out_dsp[i], blocks[b]);
+		}
+		bench_end(&clk);
+		snprintk(name, sizeof(name), "dsp_fir CMSIS, block %u", blocks[b]);
+		bench_row(name, ntaps, &clk, n);
+
+		if (memcmp(out_c, out_dsp, n * sizeof(out_c[0]))) {
+			printk("  CMSIS and generic FIR outputs differ\n\r");
+		}
+#endif
+	}
+}
+
+static void bench_dsp_biquad(void)
+{
+	struct bench_clock clk;
+	struct biquad biquad;
+	struct dsp_biquad dsp;
+	char name[32];
+
+	biquad_init(&biquad, NULL, 0);
+	bench_begin(&clk);
+	for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+		biquad_push(&biquad, trace[i]);
+		out = biquad_output(&biquad);
+	}
+	bench_end(&clk);
+	bench_row("biquad, per sample", 1, &clk, CONFIG_BENCH_ITERATIONS);
+
+	for (int b = 0; b < ARRAY_SIZE(blocks); b++) {
+		uint32_t n = whole_blocks(blocks[b]);
+
+		dsp_biquad_init(&dsp, dsp_biquad_lowpass_fs20, 1, state, 1);
+		bench_begin(&clk);
+		for (uint32_t i = 0; i < n; i += blocks[b]) {
+			dsp_biquad_process_c(&dsp, &trace[i], &out_c[i], blocks[b]);
+		}
+		bench_end(&clk);
+		snprintk(name, sizeof(name), "dsp_biquad C, block %u", blocks[b]);
+		bench_row(name, 1, &clk, n);
+
+#if defined(CONFIG_CMSIS_DSP)
+		dsp_biquad_init(&dsp, dsp_biquad_lowpass_fs20, 1, state, 1);
+		bench_begin(&clk);
+		for (uint32_t i = 0; i < n; i += blocks[b]) {
+			dsp_biquad_process(&dsp, &trace[i], &out_dsp[i], blocks[b]);
+		}
+		bench_end(&clk);
+		snprintk(name, sizeof(name), "dsp_biquad CMSIS, block %u", blocks[b]);
+		bench_row(name, 1, &clk, n);
+
+		if (memcmp(out_c, out_dsp, n * sizeof(out_c[0]))) {
+			printk("  CMSIS and generic biquad outputs differ\n\r");
+		}
+#endif
+	}
+}
+
+void bench_dsp(void)
+{
+	uint32_t seed = 0x5e7a;
+
+	/* Signal in mV with noise and occasional spikes */
+	for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		trace[i] = (seed & 0x1f) ? 1500 + (seed >> 8) % 101 - 50 : seed % 3001;
+	}
+
+	bench_header("FIR / biquad, sample by sample vs blocks");
+
+	for (int t = 0; t < ARRAY_SIZE(taps); t++) {
+		bench_dsp_fir(taps[t]);
+	}
+	bench_dsp_biquad();
+}
@@ -0,0 +1,170 @@
+/*
+ * Execução do pipeline: três threads vs k_work encadeados numa work queue
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "adc_conv.h"
+#include "cycles.h"
+#include "trimmed_mean.h"
+#include "bench.h"
+
+#define STAGE_STACK_SIZE 1024 /* Same as the pipeline threads */
+#define WINDOW 10
+
+/* Three stages per sample, as in common/src/pipeline.c */
+static struct trimmed_mean tm;
+static uint16_t tm_window[WINDOW];
+static uint32_t state;
+static uint16_t mv;
+static uint16_t filtered;
+static volatile uint32_t duty; /* keep the compiler from dropping the stages */
+static uint32_t seq;
+
+static K_THREAD_STACK_DEFINE(filter_stack, STAGE_STACK_SIZE);
+static K_THREAD_STACK_DEFINE(pwm_stack, STAGE_STACK_SIZE);
+static struct k_thread filter_thread;
+static struct k_thread pwm_thread;
+static struct k_sem to_filter, to_pwm, to_adc;
+
+static K_THREAD_STACK_DEFINE(workq_stack, STAGE_STACK_SIZE);
+static struct k_work_q workq;
+static struct k_work adc_work, filter_work, pwm_work;
+static struct k_sem done;
+
+/** @brief Etapa ADC: uma leitura bruta sintética convertida para mV */
+static void stage_adc(void)
+{
+	/* xorshift32 */
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	mv = adc_raw_to_mv(state % (ADC_RAW_MAX + 1));
+}
+
+/** @brief Etapa FILTRO: núcleo da biblioteca, janela de WINDOW amostras */
+static void stage_filter(void)
+{
+	trimmed_mean_push(&tm, mv);
+	filtered = trimmed_mean_output(&tm);
+}
+
+/** @brief Etapa PWM: cálculo do duty-cycle */
+static void stage_pwm(void)
+{
+	duty = (filtered * 100) / 3000;
+}
+
+static void reset(void)
+{
+	trimmed_mean_init(&tm, tm_window, WINDOW);
+	state = 0x5e7a;
+	seq = 0;
+}
+
+static void filter_entry(void *a, void *b, void *c)
+{
+	for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+		k_sem_take(&to_filter, K_FOREVER);
+		stage_filter();
+		k_sem_give(&to_pwm);
+	}
+}
+
+static void pwm_entry(void *a, void *b, void *c)
+{
+	for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+		k_sem_take(&to_pwm, K_FOREVER);
+		stage_pwm();
+		k_sem_give(&to_adc);
+	}
+}
+
+static void adc_handler(struct k_work *work)
+{
+	stage_adc();
+	k_work_submit_to_queue(&workq, &filter_work);
+}
+
+static void filter_handler(struct k_work *work)
+{
+	stage_filter();
+	k_work_submit_to_queue(&workq, &pwm_work);
+}
+
+static void pwm_handler(struct k_work *work)
+{
+	stage_pwm();
+	if (++seq < CONFIG_BENCH_ITERATIONS) {
+		k_work_submit_to_queue(&workq, &adc_work);
+	} else {
+		k_sem_give(&done);
+	}
+}
+
+void bench_exec(void)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	const struct k_work_queue_config cfg = { .name = "bench_workq" };
+	struct bench_clock clk;
+
+	/* Stacks and kernel objects of each mode; transports and sample blocks come on top */
+	printk("\n\rpipeline execution RAM (stacks + kernel objects)\n\r");
+	printk("%-28s %6u bytes (3 x %u stack + 3 x %u k_thread + k_timer)\n\r", "three threads",
+	       (uint32_t)(3 * (STAGE_STACK_SIZE + sizeof(struct k_thread)) + sizeof(struct k_timer)),
+	       STAGE_STACK_SIZE, (uint32_t)sizeof(struct k_thread));
+	printk("%-28s %6u bytes (%u stack + k_work_q + 3 x %u k_work + k_timer)\n\r", "work queue",
+	       (uint32_t)(STAGE_STACK_SIZE + sizeof(struct k_work_q) + 3 * sizeof(struct k_work) +
+			  sizeof(struct k_timer)),
+	       STAGE_STACK_SIZE, (uint32_t)sizeof(struct k_work));
+
+	/* Wall clock: the stages run in other threads, param = context switches per sample */
+	bench_header("pipeline execution, param = context switches per sample (wall only)");
+
+	reset();
+	bench_begin(&clk);
+	for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+		stage_adc();
+		stage_filter();
+		stage_pwm();
+	}
+	bench_end(&clk);
+	bench_row("direct calls", 0, &clk, CONFIG_BENCH_ITERATIONS);
+
+	/* main is thread_ADC, the same priority for all, one k_sem per hand-off */
+	reset();
+	k_sem_init(&to_filter, 0, 1);
+	k_sem_init(&to_pwm, 0, 1);
+	k_sem_init(&to_adc, 0, 1);
+	k_thread_create(&filter_thread, filter_stack, K_THREAD_STACK_SIZEOF(filter_stack),
+			filter_entry, NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+	k_thread_create(&pwm_thread, pwm_stack, K_THREAD_STACK_SIZEOF(pwm_stack),
+			pwm_entry, NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+	bench_begin(&clk);
+	for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+		stage_adc();
+		k_sem_give(&to_filter);
+		k_sem_take(&to_adc, K_FOREVER);
+	}
+	bench_end(&clk);
+	k_thread_join(&filter_thread, K_FOREVER);
+	k_thread_join(&pwm_thread, K_FOREVER);
+	clk.cpu = 0;
+	bench_row("three threads + k_sem", 3, &clk, CONFIG_BENCH_ITERATIONS);
+
+	/* Each stage submits the next one on the same queue, the chain ends after the last sample */
+	reset();
+	k_sem_init(&done, 0, 1);
+	k_work_queue_init(&workq);
+	k_work_queue_start(&workq, workq_stack, K_THREAD_STACK_SIZEOF(workq_stack), prio, &cfg);
+	k_work_init(&adc_work, adc_handler);
+	k_work_init(&filter_work, filter_handler);
+	k_work_init(&pwm_work, pwm_handler);
+	bench_begin(&clk);
+	k_work_submit_to_queue(&workq, &adc_work);
+	k_sem_take(&done, K_FOREVER);
+	bench_end(&clk);
+	clk.cpu = 0;
+	bench_row("k_work chain, one k_work_q", 0, &clk, CONFIG_BENCH_ITERATIONS);
+}
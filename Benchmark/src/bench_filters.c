@@ -0,0 +1,75 @@
+/*
+ * Biblioteca de filtros: ciclos por amostra de cada núcleo
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "trimmed_mean.h"
+#include "moving_avg.h"
+#include "ema.h"
+#include "median.h"
+#include "median_skiplist.h"
+#include "fir.h"
+#include "biquad.h"
+#include "bench.h"
+
+#define MAX_WINDOW 256 /**< Maior janela medida */
+
+static const uint16_t windows[] = { 10, 32, 64, 128, 256 };
+
+static uint16_t buf[MEDIAN_SKIPLIST_BUF_LEN(MAX_WINDOW)]; /* Largest working memory of all kernels */
+static uint16_t trace[CONFIG_BENCH_ITERATIONS];
+static volatile uint16_t out; /* keep the compiler from dropping the loops */
+
+/* One measurement loop per kernel, all through the common init/push/output interface */
+#define BENCH_FILTER_FN(kernel)							\
+	static void run_##kernel(uint16_t size)				\
+	{									\
+		static struct kernel f;						\
+		struct bench_clock clk;						\
+										\
+		kernel##_init(&f, buf, size);					\
+		bench_begin(&clk);						\
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {		\
+			kernel##_push(&f, trace[i]);				\
+			out = kernel##_output(&f);				\
+		}								\
+		bench_end(&clk);						\
+		bench_row(#kernel, size, &clk, CONFIG_BENCH_ITERATIONS);	\
+	}
+
+BENCH_FILTER_FN(trimmed_mean)
+BENCH_FILTER_FN(moving_avg)
+BENCH_FILTER_FN(ema)
+BENCH_FILTER_FN(median)
+BENCH_FILTER_FN(median_skiplist)
+BENCH_FILTER_FN(fir)
+BENCH_FILTER_FN(biquad)
+
+void bench_filters(void)
+{
+	uint32_t state = 0x5e7a;
+
+	/* Signal in mV with noise and occasional spikes */
+	for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		trace[i] = (state & 0x1f) ? 1500 + (state >> 8) % 101 - 50 : state % 3001;
+	}
+
+	bench_header("filter kernels (push + output)");
+
+	for (int w = 0; w < ARRAY_SIZE(windows); w++) {
+		run_trimmed_mean(windows[w]);
+		run_moving_avg(windows[w]);
+		run_ema(windows[w]);
+		run_median(windows[w]);
+		run_median_skiplist(windows[w]);
+		run_fir(windows[w]);
+	}
+
+	/* The biquad response does not depend on the window */
+	run_biquad(0);
+}
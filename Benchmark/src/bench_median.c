@@ -0,0 +1,102 @@
+/*
+ * Mediana: cópia ordenada vs skiplist indexável em janelas grandes
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "cycles.h"
+#include "median.h"
+#include "median_skiplist.h"
+#include "bench.h"
+
+#define MAX_WINDOW 1024 /**< Maior janela medida */
+#define RATE_HZ 1000 /**< Taxa de amostragem para a estimativa de carga */
+
+static const uint16_t windows[] = { 64, 128, 256, 512, 1024 };
+
+static struct median sorted;
+static struct median_skiplist skiplist;
+static uint16_t sorted_buf[MEDIAN_BUF_LEN(MAX_WINDOW)];
+static uint16_t skiplist_buf[MEDIAN_SKIPLIST_BUF_LEN(MAX_WINDOW)];
+static volatile uint16_t out; /* keep the compiler from dropping the loops */
+
+/** @brief Traço de teste: sinal em mV com ruído e picos frequentes, determinístico */
+static uint16_t trace_sample(uint32_t *state)
+{
+	/* xorshift32 */
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	if ((*state & 0x7) == 0) {
+		return *state % 3001;
+	}
+	return 1500 + (*state >> 8) % 101 - 50;
+}
+
+/** @brief Carga de CPU, em décimas de %, para uma amostra a cada 1/RATE_HZ s */
+static uint32_t load_permille(const struct bench_clock *c, uint32_t samples)
+{
+	uint64_t ns = cycles_to_ns(c->wall) / samples;
+
+	return (uint32_t)(ns * RATE_HZ / 1000000);
+}
+
+void bench_median(void)
+{
+	struct bench_clock clk;
+	uint32_t state;
+	uint32_t mismatches;
+
+	bench_header("sliding median, large windows");
+
+	for (int w = 0; w < ARRAY_SIZE(windows); w++) {
+		uint16_t size = windows[w];
+		uint32_t sorted_load;
+
+		median_init(&sorted, sorted_buf, size);
+		median_skiplist_init(&skiplist, skiplist_buf, size);
+		state = 0x5e7a;
+		mismatches = 0;
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+			uint16_t x = trace_sample(&state);
+
+			median_push(&sorted, x);
+			median_skiplist_push(&skiplist, x);
+			if (median_output(&sorted) != median_skiplist_output(&skiplist)) {
+				mismatches++;
+			}
+		}
+		if (mismatches) {
+			printk("window %u: %u skiplist output(s) differ from the sorted median\n\r",
+			       size, mismatches);
+		}
+
+		median_init(&sorted, sorted_buf, size);
+		state = 0x5e7a;
+		bench_begin(&clk);
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+			median_push(&sorted, trace_sample(&state));
+			out = median_output(&sorted);
+		}
+		bench_end(&clk);
+		bench_row("median (sorted copy)", size, &clk, CONFIG_BENCH_ITERATIONS);
+		sorted_load = load_permille(&clk, CONFIG_BENCH_ITERATIONS);
+
+		median_skiplist_init(&skiplist, skiplist_buf, size);
+		state = 0x5e7a;
+		bench_begin(&clk);
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+			median_skiplist_push(&skiplist, trace_sample(&state));
+			out = median_skiplist_output(&skiplist);
+		}
+		bench_end(&clk);
+		bench_row("median_skiplist", size, &clk, CONFIG_BENCH_ITERATIONS);
+
+		printk("  CPU load at %u Hz: sorted %u.%u %%, skiplist %u.%u %%\n\r", RATE_HZ,
+		       sorted_load / 10, sorted_load % 10,
+		       load_permille(&clk, CONFIG_BENCH_ITERATIONS) / 10,
+		       load_permille(&clk, CONFIG_BENCH_ITERATIONS) % 10);
+	}
+}
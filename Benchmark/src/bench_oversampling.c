@@ -0,0 +1,65 @@
+/*
+ * ADC: sobreamostragem em hardware vs média em software
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "adc_acq.h"
+#include "bench.h"
+#include "ref_filter.h"
+
+static struct ref_filter filter;
+
+void bench_oversampling(void)
+{
+	struct bench_clock clk;
+	uint32_t delivered;
+	int err;
+
+	err = adc_acq_init();
+	if (err) {
+		printk("bench_oversampling: ADC init failed (%d), skipped\n\r", err);
+		return;
+	}
+
+	bench_header("ADC oversampling: hardware vs software averaging");
+
+	for (uint8_t n = 0; n <= CONFIG_BENCH_OVERSAMPLING_MAX; n++) {
+		/* Hardware: each adc_read() returns the mean of 2^n conversions */
+		adc_acq_set_oversampling(n);
+		delivered = 0;
+		bench_begin(&clk);
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+			if (adc_sample()) {
+				break;
+			}
+			delivered++;
+		}
+		bench_end(&clk);
+		bench_row("hw oversampling", BIT(n), &clk, delivered);
+
+		/* Software: 2^n single reads through the original filter over a 2^n window */
+		adc_acq_set_oversampling(0);
+		ref_filter_init(&filter, BIT(n));
+		delivered = 0;
+		bench_begin(&clk);
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+			uint16_t out = 0;
+
+			for (int j = 0; j < BIT(n); j++) {
+				if (adc_sample()) {
+					goto sw_done;
+				}
+				out = ref_filter_push(&filter, adc_sample_buffer[0]);
+			}
+			ARG_UNUSED(out);
+			delivered++;
+		}
+sw_done:
+		bench_end(&clk);
+		bench_row("sw averaging (FILTRO)", BIT(n), &clk, delivered);
+	}
+
+	adc_acq_set_oversampling(CONFIG_APP_ADC_OVERSAMPLING);
+}
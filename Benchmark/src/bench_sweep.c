@@ -0,0 +1,155 @@
+/*
+ * Pipeline: período mínimo sustentável da thread_ADC
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "latency_trace.h"
+#include "pipeline.h"
+#include "pipeline_cfg.h"
+#include "transport.h"
+#include "bench.h"
+
+/* 1-2-5 series from the original period down to the timer resolution of pipeline_cfg */
+static const uint32_t periods_ms[] = { 1000, 500, 200, 100, 50, 20, 10, 5, 2, 1 };
+
+/** @brief Medições de um passo do varrimento */
+struct sweep_step {
+	uint32_t blocks;	/**< Blocos filtrados */
+	uint32_t overruns;	/**< Ativações perdidas pela thread_ADC */
+	uint32_t drops;		/**< Blocos descartados ou substituídos nas duas ligações */
+	uint32_t depth;		/**< Maior ocupação de uma das ligações */
+	uint32_t lateness_us;	/**< Maior atraso de uma ativação da thread_ADC */
+	uint32_t p99_us;	/**< Percentil 99 da latência de ponta a ponta */
+	uint32_t unstamped;	/**< Blocos que chegaram ao PWM sem t_adc */
+};
+
+/** @brief Nome da configuração de logging, para o relatório */
+static const char *log_mode(void)
+{
+	if (!IS_ENABLED(CONFIG_LOG)) {
+		return "no logging";
+	}
+	if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
+		return "deferred logging";
+	}
+	if (IS_ENABLED(CONFIG_LOG_MODE_MINIMAL)) {
+		return "minimal logging";
+	}
+	return "immediate logging";
+}
+
+/** @brief Primeiro critério que o passo falha, NULL se o período é sustentável */
+static const char *step_failure(const struct sweep_step *s, uint32_t period_ms)
+{
+	uint32_t period_us = period_ms * USEC_PER_MSEC;
+
+	if (s->overruns) {
+		return "overruns";
+	}
+	if (s->drops) {
+		return "dropped blocks";
+	}
+	if (s->depth > 1) {
+		return "queue grows";
+	}
+	if (s->lateness_us >= period_us) {
+		return "release slips";
+	}
+	if (s->blocks == 0 || s->p99_us >= period_us) {
+		return "latency above the period";
+	}
+	return NULL;
+}
+
+/** @brief Mede CONFIG_BENCH_SWEEP_BLOCKS períodos com o período corrente */
+static void measure(struct sweep_step *s, uint32_t period_ms)
+{
+	struct pipeline_counters before;
+	struct pipeline_counters after;
+
+	/* Fresh per-step maxima; the pipeline threads may race with these stores, it is only a benchmark */
+	pipeline_counters_get(&before);
+	adc_link.stats.high_water = 0;
+	pwm_link.stats.high_water = 0;
+	adc_periodic.max_lateness_us = 0;
+	latency_trace_reset();
+
+	k_msleep(period_ms * CONFIG_BENCH_SWEEP_BLOCKS);
+
+	pipeline_counters_get(&after);
+	s->blocks = after.blocks - before.blocks;
+	s->overruns = after.overruns - before.overruns;
+	s->drops = after.drops - before.drops;
+	s->depth = MAX(adc_link.stats.high_water, pwm_link.stats.high_water);
+	s->lateness_us = adc_periodic.max_lateness_us;
+	s->p99_us = latency_trace_percentile(TRACE_END_TO_END, 99) / NSEC_PER_USEC;
+	s->unstamped = latency_trace_unstamped();
+}
+
+void bench_sweep(void)
+{
+	struct pipeline_cfg cfg = { 0 };
+	uint32_t knee = 0;
+	const char *failure = NULL;
+	bool aborted = false;
+	int err;
+
+	printk("\n\rpipeline period sweep: %s, %s, %u blocks per step\n\r", TRANSPORT_NAME, log_mode(),
+	       CONFIG_BENCH_SWEEP_BLOCKS);
+	printk("%10s %8s %8s %8s %6s %12s %10s\n\r", "period ms", "blocks", "overruns", "drops",
+	       "depth", "lateness us", "p99 us");
+
+	pipeline_start();
+	pipeline_cfg_refresh(&cfg);
+
+	for (int i = 0; i < ARRAY_SIZE(periods_ms) && failure == NULL; i++) {
+		struct sweep_step s;
+		uint32_t previous_ms = cfg.period_ms;
+
+		cfg.period_ms = periods_ms[i];
+		err = pipeline_cfg_set(&cfg);
+		if (err) {
+			printk("pipeline_cfg_set() failed with error code %d\n\r", err);
+			return;
+		}
+		/* thread_ADC takes the new period at its next release, then let it settle */
+		k_msleep(previous_ms + cfg.period_ms);
+
+		measure(&s, cfg.period_ms);
+
+		/* Latencies from a block without t_adc are meaningless, so is any knee */
+		if (s.unstamped) {
+			printk("sweep aborted: %u of %u blocks without t_adc at %u ms (%s, %s)\n\r",
+			       s.unstamped, s.blocks, cfg.period_ms, TRANSPORT_NAME, log_mode());
+			aborted = true;
+			break;
+		}
+
+		failure = step_failure(&s, cfg.period_ms);
+		printk("%10u %8u %8u %8u %6u %12u %10u%s\n\r", cfg.period_ms, s.blocks, s.overruns,
+		       s.drops, s.depth, s.lateness_us, s.p99_us, failure ? " <-" : "");
+		if (failure == NULL) {
+			knee = cfg.period_ms;
+		}
+	}
+
+	/* One line per run, for the twister console harness; none after an abort, so it fails */
+	if (!aborted) {
+		if (knee == 0) {
+			printk("sweep knee: none, %s at %u ms (%s, %s)\n\r", failure, periods_ms[0],
+			       TRANSPORT_NAME, log_mode());
+		} else if (failure == NULL) {
+			printk("sweep knee: below %u ms (%s, %s)\n\r", knee, TRANSPORT_NAME,
+			       log_mode());
+		} else {
+			printk("sweep knee: %u ms, %s below it (%s, %s)\n\r", knee, failure,
+			       TRANSPORT_NAME, log_mode());
+		}
+	}
+
+	/* Back to the original rate, the pipeline keeps running */
+	cfg.period_ms = periods_ms[0];
+	pipeline_cfg_set(&cfg);
+}
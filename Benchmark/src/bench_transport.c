@@ -0,0 +1,188 @@
+/*
+ * Transportes do pipeline: latência de ativação e débito de cada primitiva
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "cycles.h"
+#include "transport.h"
+#include "bench.h"
+
+#define PRODUCER_STACK_SIZE 1024
+
+static const uint16_t bursts[] = { 1, 8, 32 };
+
+/** @brief Uma ligação do pipeline, vista através de um transporte concreto */
+struct link {
+	const char *name;
+	int (*init)(void);
+	struct sample_block *(*alloc)(void);
+	int (*send)(struct sample_block *b);
+	struct sample_block *(*recv)(k_timeout_t timeout);
+	void (*release)(struct sample_block *b);
+	const struct transport_stats *stats;
+};
+
+/* One link object and its thunks per transport, all through the common interface */
+#define BENCH_LINK(kind, label)							\
+	static struct transport_##kind kind##_link;				\
+	static int kind##_init(void)						\
+	{									\
+		return transport_##kind##_init(&kind##_link);			\
+	}									\
+	static struct sample_block *kind##_alloc(void)				\
+	{									\
+		return transport_##kind##_alloc(&kind##_link);			\
+	}									\
+	static int kind##_send(struct sample_block *b)				\
+	{									\
+		return transport_##kind##_send(&kind##_link, b);		\
+	}									\
+	static struct sample_block *kind##_recv(k_timeout_t timeout)		\
+	{									\
+		return transport_##kind##_recv(&kind##_link, timeout);		\
+	}									\
+	static void kind##_release(struct sample_block *b)			\
+	{									\
+		transport_##kind##_release(&kind##_link, b);			\
+	}									\
+	static const struct link kind##_ops = {					\
+		label, kind##_init, kind##_alloc, kind##_send, kind##_recv,	\
+		kind##_release, &kind##_link.stats,				\
+	}
+
+BENCH_LINK(fifo, "k_fifo + k_mem_slab");
+BENCH_LINK(sem, "k_sem + shared variable");
+BENCH_LINK(msgq, "k_msgq");
+BENCH_LINK(pipe, "k_pipe");
+BENCH_LINK(poll, "k_poll_signal + shared");
+BENCH_LINK(ring, "lock-free SPSC ring");
+
+static const struct link *const links[] = {
+	&fifo_ops, &sem_ops, &msgq_ops, &pipe_ops, &poll_ops, &ring_ops,
+};
+
+static K_THREAD_STACK_DEFINE(producer_stack, PRODUCER_STACK_SIZE);
+static struct k_thread producer_thread;
+
+static const struct link *cur; /**< Ligação da medição corrente */
+static uint16_t burst; /**< Blocos enviados de seguida, 0 para um de cada vez sem ceder o CPU */
+
+/** @brief Resultado de uma medição, do lado do consumidor */
+struct transport_result {
+	uint32_t received;	/**< Blocos recebidos */
+	uint32_t lost;		/**< Blocos enviados que nunca chegaram */
+	uint32_t last;		/**< cycles_now() ao receber o último bloco */
+	uint32_t lat_min;	/**< Menor latência envio -> receção (ciclos) */
+	uint32_t lat_max;	/**< Maior latência envio -> receção (ciclos) */
+	uint64_t lat_sum;	/**< Soma das latências */
+};
+
+/** @brief Produtor: faz de thread_ADC, numera os blocos no primeiro valor */
+static void producer(void *a, void *b, void *c)
+{
+	for (uint32_t seq = 0; seq < CONFIG_BENCH_ITERATIONS; seq++) {
+		struct sample_block *blk = cur->alloc();
+
+		/* An exhausted pool or a full queue shows up as lost blocks on the consumer side */
+		if (blk != NULL) {
+			blk->count = 1;
+			for (int ch = 0; ch < ADC_NUM_CHANNELS; ch++) {
+				blk->data[0][ch] = (uint16_t)seq;
+			}
+			cur->send(blk);
+		}
+
+		/* Same priority as the consumer: it only runs between bursts */
+		if (burst && (seq + 1) % burst == 0) {
+			k_yield();
+		}
+	}
+}
+
+/** @brief Consumidor: faz de thread_FILTRO até o produtor se calar */
+static void consume(struct transport_result *r)
+{
+	struct sample_block *blk;
+	uint16_t expected = 0;
+
+	r->received = 0;
+	r->lost = 0;
+	r->lat_min = UINT32_MAX;
+	r->lat_max = 0;
+	r->lat_sum = 0;
+	r->last = cycles_now();
+
+	while ((blk = cur->recv(K_MSEC(20))) != NULL) {
+		uint32_t now = cycles_now();
+		uint32_t lat = now - blk->stamp;
+
+		/* Overwritten shared blocks and drops leave gaps in the sequence */
+		r->lost += (uint16_t)(blk->data[0][0] - expected);
+		expected = blk->data[0][0] + 1;
+		r->received++;
+		r->last = now;
+		r->lat_min = MIN(r->lat_min, lat);
+		r->lat_max = MAX(r->lat_max, lat);
+		r->lat_sum += lat;
+		cur->release(blk);
+	}
+	r->lost += (uint16_t)(CONFIG_BENCH_ITERATIONS - expected);
+}
+
+/** @brief Uma medição: o produtor corre com a prioridade prio, o consumidor com a de main */
+static void run(const struct link *l, uint16_t b, int prio, struct bench_clock *clk,
+		struct transport_result *r)
+{
+	cur = l;
+	burst = b;
+	if (cur->init()) {
+		printk("%s: init failed\n\r", cur->name);
+	}
+
+	bench_begin(clk);
+	k_thread_create(&producer_thread, producer_stack, K_THREAD_STACK_SIZEOF(producer_stack),
+			producer, NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+	consume(r);
+	k_thread_join(&producer_thread, K_FOREVER);
+	bench_end(clk);
+
+	/* The consumer gives up after an idle timeout, which must not count */
+	clk->wall = r->last - clk->wall_start;
+}
+
+void bench_transport(void)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	struct transport_result r;
+	struct bench_clock clk;
+
+	/* Lower priority producer: every send wakes the blocked consumer at once */
+	printk("\n\rtransport wakeup latency, send -> receive (one block at a time)\n\r");
+	printk("%-28s %10s %10s %10s %6s\n\r", "transport", "min ns", "avg ns", "max ns", "lost");
+	for (int t = 0; t < ARRAY_SIZE(links); t++) {
+		run(links[t], 0, prio + 1, &clk, &r);
+		if (r.received == 0) {
+			printk("%-28s %10s\n\r", links[t]->name, "n/a");
+			continue;
+		}
+		printk("%-28s %10u %10u %10u %6u\n\r", links[t]->name,
+		       (uint32_t)cycles_to_ns(r.lat_min),
+		       (uint32_t)cycles_to_ns(r.lat_sum / r.received),
+		       (uint32_t)cycles_to_ns(r.lat_max), r.lost);
+	}
+
+	/* Same priority, bursts of blocks: the consumer drains what it finds between them */
+	bench_header("transport throughput, param = burst (cpu: consumer only)");
+	for (int t = 0; t < ARRAY_SIZE(links); t++) {
+		for (int b = 0; b < ARRAY_SIZE(bursts); b++) {
+			run(links[t], bursts[b], prio, &clk, &r);
+			bench_row(links[t]->name, bursts[b], &clk, r.received);
+			if (r.lost) {
+				printk("%-28s %6s %u block(s) lost\n\r", "", "", r.lost);
+			}
+			transport_report(links[t]->stats, "    link");
+		}
+	}
+}
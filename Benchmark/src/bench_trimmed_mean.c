@@ -0,0 +1,81 @@
+/*
+ * Filtro: núcleo original vs média aparada numa só passagem
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "trimmed_mean.h"
+#include "ref_filter.h"
+#include "bench.h"
+
+static const uint16_t windows[] = { 10, 16, 32, 64, 128, 256 };
+
+static struct ref_filter ref;
+static struct trimmed_mean tm;
+static uint16_t tm_window[REF_FILTER_MAX_WINDOW];
+
+/** @brief Traço de teste: sinal em mV com ruído e picos ocasionais, determinístico */
+static uint16_t trace_sample(uint32_t *state)
+{
+	/* xorshift32 */
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	if ((*state & 0x1f) == 0) {
+		return *state % 3001;
+	}
+	return 1500 + (*state >> 8) % 101 - 50;
+}
+
+void bench_trimmed_mean(void)
+{
+	struct bench_clock clk;
+	uint32_t state;
+	uint32_t mismatches;
+	volatile uint16_t out; /* keep the compiler from dropping the loops */
+
+	bench_header("trimmed mean filter");
+
+	for (int w = 0; w < ARRAY_SIZE(windows); w++) {
+		/* Same trace through both kernels, outputs must match sample by sample */
+		ref_filter_init(&ref, windows[w]);
+		trimmed_mean_init(&tm, tm_window, windows[w]);
+		state = 0x5e7a;
+		mismatches = 0;
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+			uint16_t x = trace_sample(&state);
+
+			trimmed_mean_push(&tm, x);
+			if (trimmed_mean_output(&tm) != ref_filter_push(&ref, x)) {
+				mismatches++;
+			}
+		}
+		if (mismatches) {
+			printk("window %u: %u output(s) differ from the original filter\n\r",
+			       windows[w], mismatches);
+		}
+
+		ref_filter_init(&ref, windows[w]);
+		state = 0x5e7a;
+		bench_begin(&clk);
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+			out = ref_filter_push(&ref, trace_sample(&state));
+		}
+		bench_end(&clk);
+		bench_row("original (3 passes, float)", windows[w], &clk, CONFIG_BENCH_ITERATIONS);
+
+		trimmed_mean_init(&tm, tm_window, windows[w]);
+		state = 0x5e7a;
+		bench_begin(&clk);
+		for (int i = 0; i < CONFIG_BENCH_ITERATIONS; i++) {
+			trimmed_mean_push(&tm, trace_sample(&state));
+			out = trimmed_mean_output(&tm);
+		}
+		bench_end(&clk);
+		bench_row("trimmed_mean (1 pass, int)", windows[w], &clk, CONFIG_BENCH_ITERATIONS);
+	}
+
+	ARG_UNUSED(out);
+}
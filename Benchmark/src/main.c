@@ -0,0 +1,54 @@
+/*
+ * Benchmarks do pipeline ADC -> filtro -> PWM
+ *
+ * Cada grupo de medições é ativado por uma opção BENCH_* (ver Kconfig)
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+#include "cycles.h"
+#include "bench.h"
+
+/** @brief Função main
+ *
+ * Corre, em sequência, todos os benchmarks ativos.
+ *
+ */
+void main(void)
+{
+    cycles_init();
+
+    printk("\n\r SETR pipeline benchmarks (%u samples per measurement)\n\r", CONFIG_BENCH_ITERATIONS);
+
+#if defined(CONFIG_BENCH_OVERSAMPLING)
+    bench_oversampling();
+#endif
+#if defined(CONFIG_BENCH_CONVERSION)
+    bench_conversion();
+#endif
+#if defined(CONFIG_BENCH_TRIMMED_MEAN)
+    bench_trimmed_mean();
+#endif
+#if defined(CONFIG_BENCH_FILTERS)
+    bench_filters();
+#endif
+#if defined(CONFIG_BENCH_MEDIAN)
+    bench_median();
+#endif
+#if defined(CONFIG_BENCH_DSP)
+    bench_dsp();
+#endif
+#if defined(CONFIG_BENCH_TRANSPORT)
+    bench_transport();
+#endif
+#if defined(CONFIG_BENCH_EXEC)
+    bench_exec();
+#endif
+#if defined(CONFIG_BENCH_SWEEP)
+    /* Last: it starts the pipeline threads, which keep running */
+    bench_sweep();
+#endif
+
+    printk("\n\r Benchmarks done\n\r");
+}
@@ -0,0 +1,55 @@
+/*
+ * Cópia de referência do núcleo original da thread_FILTRO
+ */
+
+#include <zephyr.h>
+
+#include "ref_filter.h"
+
+void ref_filter_init(struct ref_filter *f, int size)
+{
+	memset(f, 0, sizeof(*f));
+	f->size = size;
+}
+
+uint16_t ref_filter_push(struct ref_filter *f, uint16_t sample)
+{
+    int media=0,desvio=0;
+    int sum_final,sum,k;
+
+    sum=0;
+    f->array[f->idx]=sample;
+    f->idx++;
+    f->idx%=f->size;
+    for(int i=0;i<f->size;i++)
+    {
+      sum+=f->array[i];
+    }
+    media=sum/f->size;
+    desvio=media*0.1;
+
+    k=0;
+
+    for(int j=0;j<f->size;j++)
+    {
+      if(f->array[j]>=(media-desvio) && f->array[j]<=(media+desvio))
+      {
+        f->array2[k]=f->array[j];
+        k++;
+      }
+    }
+
+    sum_final=0;
+
+    for(int l=0;l<k;l++)
+    {
+      sum_final+=f->array2[l];
+    }
+
+    if(k==0)
+    {
+      k=1;
+    }
+
+    return sum_final/k;
+}
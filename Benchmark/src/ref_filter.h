@@ -0,0 +1,31 @@
+/*
+ * Cópia de referência do núcleo original da thread_FILTRO
+ */
+
+#ifndef REF_FILTER_H
+#define REF_FILTER_H
+
+#include <zephyr.h>
+
+#define REF_FILTER_MAX_WINDOW 256 /**< Maior janela suportada */
+
+/** @brief Estado do filtro de referência */
+struct ref_filter {
+	uint16_t array[REF_FILTER_MAX_WINDOW];	/**< Janela de amostras */
+	uint16_t array2[REF_FILTER_MAX_WINDOW];	/**< Amostras dentro da banda de 10% */
+	int size;				/**< Tamanho da janela */
+	int idx;				/**< Próxima posição a escrever */
+};
+
+/** @brief Inicializa o filtro com a janela a zeros, como a thread_FILTRO original */
+void ref_filter_init(struct ref_filter *f, int size);
+
+/** @brief Introduz uma amostra e devolve a média final
+ *
+ * Reproduz literalmente o algoritmo original: soma da janela inteira,
+ * banda de 10% calculada em vírgula flutuante, cópia das amostras dentro
+ * da banda para array2 e nova soma.
+ */
+uint16_t ref_filter_push(struct ref_filter *f, uint16_t sample);
+
+#endif /* REF_FILTER_H */
@@ -0,0 +1,52 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+# Código partilhado pelas aplicações Fifo e Semaphores
+
+target_include_directories(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/include)
+
+target_sources(app PRIVATE
+  ${CMAKE_CURRENT_LIST_DIR}/src/adc_acq.c
+  ${CMAKE_CURRENT_LIST_DIR}/src/duty_meter.c
+  ${CMAKE_CURRENT_LIST_DIR}/src/latency_trace.c
+  ${CMAKE_CURRENT_LIST_DIR}/src/periodic.c
+  ${CMAKE_CURRENT_LIST_DIR}/src/pipeline_cfg.c
+  ${CMAKE_CURRENT_LIST_DIR}/src/sched_rta.c
+  ${CMAKE_CURRENT_LIST_DIR}/src/spsc_ring.c
+  ${CMAKE_CURRENT_LIST_DIR}/src/transport.c
+)
+target_sources_ifdef(CONFIG_APP_THREAD_STATS app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/thread_stats.c)
+target_sources_ifdef(CONFIG_APP_SHELL app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/pipeline_shell.c)
+target_sources_ifdef(CONFIG_APP_REPLAY app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/replay.c)
+
+# Board hooks: the ADC specifics of each driver, and the board PWM or its stub
+if(CONFIG_ADC_NRFX_SAADC)
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/adc_board_nrf.c)
+elseif(CONFIG_ADC_EMUL)
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/adc_board_emul.c)
+else()
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/adc_board_generic.c)
+endif()
+if(CONFIG_APP_PWM_STUB)
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/pwm_stub.c)
+else()
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/pwm_out.c)
+endif()
+
+# Filter kernels, one translation unit each
+target_sources_ifdef(CONFIG_APP_FILTER_LIB_TRIMMED_MEAN app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/trimmed_mean.c)
+target_sources_ifdef(CONFIG_APP_FILTER_LIB_MOVING_AVG app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/moving_avg.c)
+target_sources_ifdef(CONFIG_APP_FILTER_LIB_EMA app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/ema.c)
+target_sources_ifdef(CONFIG_APP_FILTER_LIB_MEDIAN app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/median.c)
+target_sources_ifdef(CONFIG_APP_FILTER_LIB_MEDIAN_SKIPLIST app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/median_skiplist.c)
+target_sources_ifdef(CONFIG_APP_FILTER_LIB_FIR app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/fir.c)
+target_sources_ifdef(CONFIG_APP_FILTER_LIB_BIQUAD app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/biquad.c)
+target_sources_ifdef(CONFIG_APP_FILTER_LIB_DSP app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/dsp_filter.c)
+target_sources_ifdef(CONFIG_APP_FILTER_BLOCK app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/filter_block.c)
+
+# Inter-thread transports, one translation unit each
+target_sources_ifdef(CONFIG_APP_TRANSPORT_LIB_FIFO app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/transport_fifo.c)
+target_sources_ifdef(CONFIG_APP_TRANSPORT_LIB_SEM app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/transport_sem.c)
+target_sources_ifdef(CONFIG_APP_TRANSPORT_LIB_MSGQ app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/transport_msgq.c)
+target_sources_ifdef(CONFIG_APP_TRANSPORT_LIB_PIPE app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/transport_pipe.c)
+target_sources_ifdef(CONFIG_APP_TRANSPORT_LIB_POLL app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/transport_poll.c)
+target_sources_ifdef(CONFIG_APP_TRANSPORT_LIB_RING app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/src/transport_ring.c)
@@ -0,0 +1,112 @@
+/*
+ * Aquisição de amostras da ADC, partilhada pelas aplicações Fifo e Semaphores
+ */
+
+#ifndef ADC_ACQ_H
+#define ADC_ACQ_H
+
+#include <zephyr.h>
+#include <device.h>
+#include <devicetree.h>
+#include <drivers/adc.h>
+
+/*ADC definitions*/
+#define ADC_NID DT_NODELABEL(adc) /**< Node label da ADC */
+#define ADC_RESOLUTION 10 /**< Resolução da ADC */
+#define ADC_GAIN ADC_GAIN_1_4 /**< Ganho da ADC */
+#define ADC_REFERENCE ADC_REF_VDD_1_4 /**< Tensão de referência da ADC */
+#if defined(CONFIG_ADC_EMUL)
+/* The ADC emulator only accepts the default acquisition time */
+#define ADC_ACQUISITION_TIME ADC_ACQ_TIME_DEFAULT /**< Tempo de aquisição da ADC */
+#else
+#define ADC_ACQUISITION_TIME ADC_ACQ_TIME(ADC_ACQ_TIME_MICROSECONDS, 40) /**< Tempo de aquisição da ADC */
+#endif
+#define ADC_CHANNEL_ID 1  /**< ID do canal da ADC quando o devicetree não define canais */
+
+/* The scanned channels come from the io-channels of the zephyr,user node in the board overlay */
+#define ADC_USER_NID DT_PATH(zephyr_user) /**< Nó do devicetree com a lista de canais */
+#if DT_NODE_HAS_PROP(ADC_USER_NID, io_channels)
+#define ADC_NUM_CHANNELS DT_PROP_LEN(ADC_USER_NID, io_channels) /**< Número de canais lidos em cada varrimento */
+#else
+#define ADC_NUM_CHANNELS 1 /**< Número de canais lidos em cada varrimento */
+#endif
+
+#if defined(CONFIG_APP_ADC_CONTINUOUS)
+#define ADC_BURST_SAMPLES CONFIG_APP_ADC_BURST_SAMPLES /**< Amostras adquiridas por cada adc_read() */
+#else
+#define ADC_BURST_SAMPLES 1 /**< Amostras adquiridas por cada adc_read() */
+#endif
+
+/* One scan holds one sample of every channel, in ascending channel order */
+#define BUFFER_SIZE (ADC_BURST_SAMPLES * ADC_NUM_CHANNELS) /**< Tamanho do buffer de amostragem da ADC */
+
+extern const struct device *adc_dev; /**< Ponteiro para a estrutura do tipo "device" */
+extern const uint8_t adc_channel_inputs[ADC_NUM_CHANNELS]; /**< Entrada ANx de cada canal, por ordem crescente */
+extern uint16_t *adc_sample_buffer; /**< Buffer com as últimas amostras entregues por adc_sample() */
+
+/** @brief Inicializa a ADC
+ *
+ * Faz o bind ao dispositivo, configura os canais e faz a preparação
+ * própria da placa (adc_board.h): calibra a SAADC ou impõe as formas de
+ * onda às entradas do emulador.
+ * O canal n lê a entrada ANn; os canais têm de estar listados por ordem
+ * crescente no devicetree, que é a ordem em que a ADC os guarda no buffer.
+ *
+ * @return 0 em caso de sucesso, código de erro negativo caso contrário.
+ */
+int adc_acq_init(void);
+
+/** @brief Função que adquire amostras da ADC
+ *
+ * Preenche adc_sample_buffer com ADC_BURST_SAMPLES varrimentos de todos os
+ * canais: a amostra do canal c no varrimento s está em
+ * adc_sample_buffer[s * ADC_NUM_CHANNELS + c]. Em modo contínuo (CONFIG_APP_ADC_CONTINUOUS) as amostras são espaçadas de
+ * CONFIG_APP_ADC_INTERVAL_US pelo driver da ADC.
+ *
+ * Em modo assíncrono (CONFIG_APP_ADC_ASYNC) entrega a conversão que já
+ * estava em curso e arma imediatamente a seguinte, que decorre enquanto
+ * o chamador processa adc_sample_buffer.
+ *
+ * @return 0 em caso de sucesso, código de erro caso contrário.
+ */
+int adc_sample(void);
+
+/** @brief Altera a sobreamostragem em hardware
+ *
+ * Aplica-se a partir da próxima conversão armada. O valor inicial é
+ * CONFIG_APP_ADC_OVERSAMPLING. A SAADC só sobreamostra com um único canal
+ * ativo; com vários canais o adc_read() seguinte falha com -EINVAL.
+ *
+ * @param oversampling Cada amostra é a média de 2^oversampling conversões.
+ */
+void adc_acq_set_oversampling(uint8_t oversampling);
+
+/** @brief Número de varrimentos válidos da última rajada
+ *
+ * @return Número de varrimentos escritos em adc_sample_buffer pelo último adc_sample().
+ */
+uint16_t adc_sample_count(void);
+
+/** @brief Instante em que terminou a conversão entregue pelo último adc_sample()
+ *
+ * @return Valor de cycles_now() registado pelo callback do driver da ADC.
+ */
+uint32_t adc_sample_stamp(void);
+
+/** @brief Recebe um varrimento (um valor raw por canal), em contexto de interrupção */
+typedef void (*adc_scan_callback_t)(const uint16_t *scan);
+
+/** @brief Arranca a aquisição por interrupção (CONFIG_APP_ADC_ISR)
+ *
+ * Arma uma única conversão assíncrona cujo callback, no fim de cada
+ * varrimento, chama cb e pede ao driver que repita a amostragem
+ * (ADC_ACTION_REPEAT) passados interval_us. Não há thread de aquisição
+ * nem chamadas a adc_sample(); cb não pode bloquear.
+ *
+ * @param interval_us Período de amostragem, marcado pelo driver da ADC.
+ * @param cb Função chamada com cada varrimento.
+ * @return 0 em caso de sucesso, código de erro negativo caso contrário.
+ */
+int adc_acq_start(uint32_t interval_us, adc_scan_callback_t cb);
+
+#endif /* ADC_ACQ_H */
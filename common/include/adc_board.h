@@ -0,0 +1,32 @@
+/*
+ * Particularidades da ADC de cada placa, isoladas de adc_acq.c
+ *
+ * Há uma implementação por ADC, escolhida pelo driver ativo: a SAADC
+ * do nRF52840 (adc_board_nrf.c), o emulador da ADC usado em native_posix
+ * e qemu_cortex_m3 (adc_board_emul.c) e, para as outras, nenhuma
+ * particularidade (adc_board_generic.c).
+ */
+
+#ifndef ADC_BOARD_H
+#define ADC_BOARD_H
+
+#include <zephyr.h>
+#include <device.h>
+#include <drivers/adc.h>
+
+/** @brief Completa a configuração de um canal antes de adc_channel_setup()
+ *
+ * @param cfg Configuração comum, com channel_id já preenchido.
+ * @param input Entrada ANx lida pelo canal.
+ */
+void adc_board_channel_cfg(struct adc_channel_cfg *cfg, uint8_t input);
+
+/** @brief Preparação da ADC depois de configurados todos os canais
+ *
+ * Calibração da SAADC, ou forma de onda inicial de cada canal emulado.
+ *
+ * @return 0 em caso de sucesso, código de erro negativo caso contrário.
+ */
+int adc_board_init(const struct device *dev);
+
+#endif /* ADC_BOARD_H */
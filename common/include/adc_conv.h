@@ -0,0 +1,46 @@
+/*
+ * Conversão das leituras da ADC para milivolts em aritmética inteira
+ */
+
+#ifndef ADC_CONV_H
+#define ADC_CONV_H
+
+#include <zephyr.h>
+
+#include "adc_acq.h"
+
+#define ADC_RAW_MAX (BIT(ADC_RESOLUTION) - 1) /**< Maior leitura da ADC na resolução configurada */
+
+/* mV = raw * FULL_SCALE * GAIN / RAW_MAX + OFFSET, as a 32x32->64 multiply and a shift */
+#define ADC_CONV_SHIFT 24 /**< Bits fracionários do fator de escala */
+#define ADC_CONV_DEN ((uint64_t)1000000 * ADC_RAW_MAX) /**< Denominador do fator de escala (ppm * RAW_MAX) */
+#define ADC_CONV_SCALE ((uint32_t)((((uint64_t)CONFIG_APP_ADC_FULL_SCALE_MV * \
+				     CONFIG_APP_ADC_CAL_GAIN_PPM << ADC_CONV_SHIFT) + \
+				    ADC_CONV_DEN / 2) / ADC_CONV_DEN)) /**< mV por LSB, em vírgula fixa */
+
+BUILD_ASSERT(ADC_CONV_SCALE > 0, "ADC conversion scale underflows");
+BUILD_ASSERT(((uint64_t)CONFIG_APP_ADC_FULL_SCALE_MV * CONFIG_APP_ADC_CAL_GAIN_PPM << ADC_CONV_SHIFT) /
+	     ADC_CONV_DEN <= UINT32_MAX, "ADC conversion scale overflows");
+
+/** @brief Converte uma leitura da ADC para milivolts
+ *
+ * Usa o fator de escala calculado em tempo de compilação a partir de
+ * ADC_RESOLUTION, CONFIG_APP_ADC_FULL_SCALE_MV e da calibração
+ * (CONFIG_APP_ADC_CAL_GAIN_PPM, CONFIG_APP_ADC_CAL_OFFSET_MV). O resultado
+ * é arredondado ao milivolt mais próximo e limitado a 0..UINT16_MAX.
+ *
+ * @param raw Leitura da ADC.
+ * @return Tensão em mV.
+ */
+static inline uint16_t adc_raw_to_mv(uint16_t raw)
+{
+	int32_t mv = (int32_t)(((uint64_t)raw * ADC_CONV_SCALE + BIT(ADC_CONV_SHIFT - 1)) >>
+			       ADC_CONV_SHIFT) + CONFIG_APP_ADC_CAL_OFFSET_MV;
+
+	if (mv < 0) {
+		return 0;
+	}
+	return mv > UINT16_MAX ? UINT16_MAX : mv;
+}
+
+#endif /* ADC_CONV_H */
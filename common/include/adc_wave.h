@@ -0,0 +1,51 @@
+/*
+ * Formas de onda impostas às entradas do emulador da ADC
+ *
+ * Sem placa (native_posix, qemu_cortex_m3) cada canal da ADC emulada lê
+ * uma forma de onda programável, em vez de uma tensão constante. A
+ * forma inicial vem de APP_ADC_EMUL_WAVE; adc_wave_set() muda-a em
+ * qualquer altura, p.ex. para reproduzir uma sequência de amostras.
+ */
+
+#ifndef ADC_WAVE_H
+#define ADC_WAVE_H
+
+#include <zephyr.h>
+
+/** @brief Forma de onda de um canal */
+enum adc_wave_shape {
+	ADC_WAVE_CONST,		/**< offset_mv */
+	ADC_WAVE_SINE,		/**< Sinusoide de amplitude amplitude_mv à volta de offset_mv */
+	ADC_WAVE_SQUARE,	/**< offset_mv + amplitude_mv na 1.ª metade do período, - na 2.ª */
+	ADC_WAVE_TRIANGLE,	/**< Triangular entre offset_mv - amplitude_mv e offset_mv + amplitude_mv */
+	ADC_WAVE_TABLE,		/**< Valores de table, um por step_us ou um por conversão */
+};
+
+/** @brief Descrição de uma forma de onda */
+struct adc_wave {
+	enum adc_wave_shape shape;	/**< Forma */
+	uint16_t offset_mv;		/**< Valor médio */
+	uint16_t amplitude_mv;		/**< Amplitude (pico) */
+	uint32_t period_us;		/**< Período das formas periódicas */
+	uint16_t noise_mv;		/**< Ruído uniforme somado, em ±noise_mv */
+	const uint16_t *table;		/**< ADC_WAVE_TABLE: valores em mV, repetidos no fim */
+	uint32_t table_len;		/**< ADC_WAVE_TABLE: número de valores */
+	uint32_t step_us;		/**< ADC_WAVE_TABLE: duração de cada valor; 0 avança um por conversão */
+};
+
+/** @brief Impõe uma forma de onda à entrada de um canal
+ *
+ * A fase começa no instante da chamada. O valor lido é limitado a
+ * [0, APP_ADC_FULL_SCALE_MV]. A descrição é copiada, mas table tem de
+ * existir enquanto estiver em uso.
+ *
+ * @param c Canal (0..ADC_NUM_CHANNELS - 1, como em adc_channel_inputs).
+ * @param w Forma de onda.
+ * @return 0 em caso de sucesso, código de erro negativo caso contrário.
+ */
+int adc_wave_set(int c, const struct adc_wave *w);
+
+/** @brief Conversões servidas a um canal desde o último adc_wave_set() */
+uint32_t adc_wave_samples(int c);
+
+#endif /* ADC_WAVE_H */
@@ -0,0 +1,49 @@
+/*
+ * Filtro IIR biquad (forma direta I)
+ */
+
+#ifndef BIQUAD_H
+#define BIQUAD_H
+
+#include <zephyr.h>
+
+#define BIQUAD_BUF_LEN(size) 0 /**< O filtro não usa memória de trabalho */
+#define BIQUAD_Q 14 /**< Bits fracionários dos coeficientes */
+
+/** @brief Coeficientes em Q14, com a0 normalizado a 1
+ *
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+struct biquad_coeffs {
+	int16_t b0, b1, b2;
+	int16_t a1, a2;
+};
+
+/** @brief Estado do filtro */
+struct biquad {
+	const struct biquad_coeffs *c;	/**< Coeficientes */
+	int32_t x1, x2;			/**< Entradas anteriores */
+	int32_t y1, y2;			/**< Saídas anteriores, com 8 bits fracionários */
+};
+
+/** @brief Passa-baixo de Butterworth de 2.ª ordem com corte a fs/20 */
+extern const struct biquad_coeffs biquad_lowpass_fs20;
+
+/** @brief Inicializa o filtro com o estado a zeros e biquad_lowpass_fs20
+ *
+ * @param f Filtro.
+ * @param buf Não usado (BIQUAD_BUF_LEN(size) é 0).
+ * @param size Não usado: a resposta é definida pelos coeficientes.
+ */
+void biquad_init(struct biquad *f, uint16_t *buf, uint16_t size);
+
+/** @brief Substitui os coeficientes */
+void biquad_set_coeffs(struct biquad *f, const struct biquad_coeffs *c);
+
+/** @brief Introduz uma amostra e calcula a nova saída */
+void biquad_push(struct biquad *f, uint16_t sample);
+
+/** @brief Saída corrente, limitada a 0..UINT16_MAX */
+uint16_t biquad_output(const struct biquad *f);
+
+#endif /* BIQUAD_H */
@@ -0,0 +1,46 @@
+/*
+ * Contador de ciclos portável, usado pela instrumentação do pipeline
+ */
+
+#ifndef CYCLES_H
+#define CYCLES_H
+
+#include <zephyr.h>
+#if defined(CONFIG_TIMING_FUNCTIONS)
+#include <timing/timing.h>
+#endif
+
+/** @brief Inicializa o contador de ciclos (pode ser chamada por várias threads) */
+static inline void cycles_init(void)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	timing_init();
+	timing_start();
+#endif
+}
+
+/** @brief Valor corrente do contador de ciclos
+ *
+ * Usa as timing functions quando a placa as suporta e k_cycle_get_32()
+ * caso contrário (p.ex. native_posix). Só as diferenças são significativas.
+ */
+static inline uint32_t cycles_now(void)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	return (uint32_t)timing_counter_get();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+/** @brief Converte um número de ciclos de cycles_now() em nanosegundos */
+static inline uint64_t cycles_to_ns(uint64_t cycles)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	return timing_cycles_to_ns(cycles);
+#else
+	return k_cyc_to_ns_floor64(cycles);
+#endif
+}
+
+#endif /* CYCLES_H */
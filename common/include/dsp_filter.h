@@ -0,0 +1,95 @@
+/*
+ * Filtros FIR e IIR biquad em Q15, processados por blocos
+ *
+ * Em Cortex-M com CONFIG_CMSIS_DSP usa arm_fir_q15() e
+ * arm_biquad_cascade_df1_q15(), que usam as instruções SIMD de dupla
+ * multiplicação-acumulação (SMLAD/SMLALD). Nas restantes plataformas
+ * (native_posix) usa núcleos em C genérico com o mesmo resultado.
+ */
+
+#ifndef DSP_FILTER_H
+#define DSP_FILTER_H
+
+#include <zephyr.h>
+
+#if defined(CONFIG_CMSIS_DSP)
+#include <arm_math.h>
+#else
+typedef int16_t q15_t; /**< Amostra ou coeficiente em Q15 */
+#endif
+
+#define DSP_FIR_STATE_LEN(taps, block) ((taps) + (block) - 1) /**< Elementos do estado de um FIR */
+#define DSP_BIQUAD_STATE_LEN(stages) (4 * (stages)) /**< Elementos do estado de uma cascata de biquads */
+#define DSP_BIQUAD_COEFFS_LEN(stages) (6 * (stages)) /**< Elementos dos coeficientes de uma cascata de biquads */
+
+/** @brief Estado de um FIR */
+struct dsp_fir {
+	const q15_t *coeffs;	/**< Coeficientes por ordem inversa: coeffs[taps - 1] aplica-se à amostra mais recente */
+	q15_t *state;		/**< Histórico seguido do bloco corrente */
+	uint16_t taps;		/**< Número de coeficientes (par, >= 4) */
+#if defined(CONFIG_CMSIS_DSP)
+	arm_fir_instance_q15 arm; /**< Instância CMSIS-DSP */
+#endif
+};
+
+/** @brief Estado de uma cascata de biquads (forma direta I) */
+struct dsp_biquad {
+	const q15_t *coeffs;	/**< {b0, 0, b1, b2, a1, a2} por andar, em Q(15 - post_shift) */
+	q15_t *state;		/**< {x[n-1], x[n-2], y[n-1], y[n-2]} por andar */
+	uint8_t stages;		/**< Número de andares */
+	int8_t post_shift;	/**< Deslocamento que permite coeficientes em ]-2^post_shift, 2^post_shift[ */
+#if defined(CONFIG_CMSIS_DSP)
+	arm_biquad_casd_df1_inst_q15 arm; /**< Instância CMSIS-DSP */
+#endif
+};
+
+/** @brief Passa-baixo de Butterworth de 2.ª ordem com corte a fs/20, post_shift 1
+ *
+ * Na convenção CMSIS-DSP: y = b0 x + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2].
+ */
+extern const q15_t dsp_biquad_lowpass_fs20[DSP_BIQUAD_COEFFS_LEN(1)];
+
+/** @brief Inicializa um FIR com o estado a zeros
+ *
+ * @param f Filtro.
+ * @param coeffs taps coeficientes, por ordem inversa.
+ * @param taps Número de coeficientes; par e pelo menos 4, como exige arm_fir_q15().
+ * @param state Memória com DSP_FIR_STATE_LEN(taps, max_block) elementos.
+ * @param max_block Maior bloco passado a dsp_fir_process().
+ * @return 0 em caso de sucesso, -EINVAL se taps não for válido.
+ */
+int dsp_fir_init(struct dsp_fir *f, const q15_t *coeffs, uint16_t taps, q15_t *state,
+		 uint16_t max_block);
+
+/** @brief Filtra um bloco de n amostras (saturado a Q15) */
+void dsp_fir_process(struct dsp_fir *f, const q15_t *in, q15_t *out, uint16_t n);
+
+/** @brief dsp_fir_process() em C genérico, mesmo com CMSIS-DSP disponível */
+void dsp_fir_process_c(struct dsp_fir *f, const q15_t *in, q15_t *out, uint16_t n);
+
+/** @brief Coeficientes triangulares (Bartlett) de ganho unitário em DC
+ *
+ * @param coeffs Destino, com taps elementos.
+ * @param taps Número de coeficientes (>= 3); se for par, o coeficiente da
+ * amostra mais antiga fica a zero, para que a resposta seja simétrica.
+ */
+void dsp_fir_triangular(q15_t *coeffs, uint16_t taps);
+
+/** @brief Inicializa uma cascata de biquads com o estado a zeros
+ *
+ * @param f Filtro.
+ * @param coeffs DSP_BIQUAD_COEFFS_LEN(stages) coeficientes.
+ * @param stages Número de andares.
+ * @param state Memória com DSP_BIQUAD_STATE_LEN(stages) elementos.
+ * @param post_shift Escala dos coeficientes.
+ */
+void dsp_biquad_init(struct dsp_biquad *f, const q15_t *coeffs, uint8_t stages, q15_t *state,
+		     int8_t post_shift);
+
+/** @brief Filtra um bloco de n amostras (saturado a Q15) */
+void dsp_biquad_process(struct dsp_biquad *f, const q15_t *in, q15_t *out, uint16_t n);
+
+/** @brief dsp_biquad_process() em C genérico, mesmo com CMSIS-DSP disponível */
+void dsp_biquad_process_c(struct dsp_biquad *f, const q15_t *in, q15_t *out, uint16_t n);
+
+#endif /* DSP_FILTER_H */
@@ -0,0 +1,32 @@
+/*
+ * Medição do duty-cycle efetivo de uma thread periódica
+ */
+
+#ifndef DUTY_METER_H
+#define DUTY_METER_H
+
+#include <zephyr.h>
+
+/** @brief Estado da medição do duty-cycle */
+struct duty_meter {
+	const char *name;	/**< Nome usado nos relatórios */
+	uint32_t last;		/**< Instante (ciclos) da última transição */
+	uint64_t busy;		/**< Ciclos ocupados na janela corrente */
+	uint64_t idle;		/**< Ciclos à espera na janela corrente */
+	uint32_t activations;	/**< Ativações na janela corrente */
+};
+
+/** @brief Inicializa a medição; a thread é considerada ocupada a partir daqui */
+void duty_meter_init(struct duty_meter *m, const char *name);
+
+/** @brief A thread foi ativada e começa a trabalhar */
+void duty_meter_busy(struct duty_meter *m);
+
+/** @brief A thread vai bloquear à espera da próxima ativação
+ *
+ * A cada CONFIG_APP_DUTY_REPORT ativações imprime a percentagem do tempo
+ * em que a thread esteve ocupada e reinicia a janela.
+ */
+void duty_meter_idle(struct duty_meter *m);
+
+#endif /* DUTY_METER_H */
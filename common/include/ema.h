@@ -0,0 +1,35 @@
+/*
+ * Média móvel exponencial
+ */
+
+#ifndef EMA_H
+#define EMA_H
+
+#include <zephyr.h>
+
+#define EMA_BUF_LEN(size) 0 /**< O filtro não usa memória de trabalho */
+
+/** @brief Estado do filtro */
+struct ema {
+	int32_t y;		/**< Saída corrente, com 8 bits fracionários */
+	int32_t alpha;		/**< Peso da nova amostra, em Q15 */
+};
+
+/** @brief Inicializa o filtro com a saída a zero
+ *
+ * O peso da nova amostra é alpha = 2 / (size + 1), que dá o mesmo atraso
+ * médio que uma média móvel de size amostras.
+ *
+ * @param f Filtro.
+ * @param buf Não usado (EMA_BUF_LEN(size) é 0).
+ * @param size Janela equivalente.
+ */
+void ema_init(struct ema *f, uint16_t *buf, uint16_t size);
+
+/** @brief Introduz uma amostra: y += alpha * (x - y) */
+void ema_push(struct ema *f, uint16_t sample);
+
+/** @brief Saída corrente, arredondada */
+uint16_t ema_output(const struct ema *f);
+
+#endif /* EMA_H */
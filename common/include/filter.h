@@ -0,0 +1,81 @@
+/*
+ * Filtro digital da thread_FILTRO, escolhido em tempo de compilação
+ *
+ * Todos os filtros têm a mesma interface: <nome>_init(f, buf, size),
+ * <nome>_push(f, amostra) e <nome>_output(f). Este ficheiro liga
+ * filter_t, filter_init(), filter_push() e filter_output() ao filtro
+ * escolhido em APP_FILTER, sem custo de chamada indireta.
+ */
+
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <zephyr.h>
+
+#if defined(CONFIG_APP_FILTER_MOVING_AVG)
+#include "moving_avg.h"
+typedef struct moving_avg filter_t; /**< Estado do filtro escolhido */
+#define FILTER_NAME "moving average" /**< Nome do filtro escolhido */
+#define FILTER_BUF_LEN(size) MOVING_AVG_BUF_LEN(size) /**< Memória de trabalho do filtro escolhido */
+#define filter_init moving_avg_init
+#define filter_push moving_avg_push
+#define filter_output moving_avg_output
+#elif defined(CONFIG_APP_FILTER_EMA)
+#include "ema.h"
+typedef struct ema filter_t;
+#define FILTER_NAME "exponential moving average"
+#define FILTER_BUF_LEN(size) EMA_BUF_LEN(size)
+#define filter_init ema_init
+#define filter_push ema_push
+#define filter_output ema_output
+#elif defined(CONFIG_APP_FILTER_MEDIAN)
+#include "median.h"
+typedef struct median filter_t;
+#define FILTER_NAME "windowed median"
+#define FILTER_BUF_LEN(size) MEDIAN_BUF_LEN(size)
+#define filter_init median_init
+#define filter_push median_push
+#define filter_output median_output
+#elif defined(CONFIG_APP_FILTER_MEDIAN_SKIPLIST)
+#include "median_skiplist.h"
+typedef struct median_skiplist filter_t;
+#define FILTER_NAME "windowed median (skiplist)"
+#define FILTER_BUF_LEN(size) MEDIAN_SKIPLIST_BUF_LEN(size)
+#define filter_init median_skiplist_init
+#define filter_push median_skiplist_push
+#define filter_output median_skiplist_output
+#elif defined(CONFIG_APP_FILTER_FIR)
+#include "fir.h"
+typedef struct fir filter_t;
+#define FILTER_NAME "FIR"
+#define FILTER_BUF_LEN(size) FIR_BUF_LEN(size)
+#define filter_init fir_init
+#define filter_push fir_push
+#define filter_output fir_output
+#elif defined(CONFIG_APP_FILTER_BIQUAD)
+#include "biquad.h"
+typedef struct biquad filter_t;
+#define FILTER_NAME "biquad IIR"
+#define FILTER_BUF_LEN(size) BIQUAD_BUF_LEN(size)
+#define filter_init biquad_init
+#define filter_push biquad_push
+#define filter_output biquad_output
+#elif defined(CONFIG_APP_FILTER_BLOCK)
+/* Block processing has its own interface, see filter_block.h */
+#include "filter_block.h"
+#if defined(CONFIG_APP_FILTER_BLOCK_FIR)
+#define FILTER_NAME "block FIR"
+#else
+#define FILTER_NAME "block biquad"
+#endif
+#else
+#include "trimmed_mean.h"
+typedef struct trimmed_mean filter_t;
+#define FILTER_NAME "10% trimmed mean"
+#define FILTER_BUF_LEN(size) TRIMMED_MEAN_BUF_LEN(size)
+#define filter_init trimmed_mean_init
+#define filter_push trimmed_mean_push
+#define filter_output trimmed_mean_output
+#endif
+
+#endif /* FILTER_H */
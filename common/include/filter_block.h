@@ -0,0 +1,53 @@
+/*
+ * Etapa de filtragem por blocos da thread_FILTRO (CONFIG_APP_FILTER_BLOCK)
+ */
+
+#ifndef FILTER_BLOCK_H
+#define FILTER_BLOCK_H
+
+#include <zephyr.h>
+
+#include "dsp_filter.h"
+
+#define FILTER_BLOCK_SIZE CONFIG_APP_FILTER_BLOCK_SIZE /**< Maior bloco processado de uma vez */
+/* arm_fir_q15() needs an even number of taps, at least 4 */
+#define FILTER_BLOCK_TAPS MAX(4, ROUND_UP(CONFIG_APP_FILTER_WINDOW, 2)) /**< Coeficientes do FIR */
+/* mV leave 3 bits of headroom in Q15 (full scale below 4096 mV), used to cut the rounding error */
+#define FILTER_BLOCK_SHIFT 3 /**< Escala das amostras em mV para Q15 */
+
+/** @brief Estado da etapa para um canal */
+struct filter_block {
+#if defined(CONFIG_APP_FILTER_BLOCK_FIR)
+	struct dsp_fir fir;					/**< FIR */
+	q15_t state[DSP_FIR_STATE_LEN(FILTER_BLOCK_TAPS, FILTER_BLOCK_SIZE)]; /**< Estado do FIR */
+#else
+	struct dsp_biquad biquad;				/**< Biquad */
+	q15_t state[DSP_BIQUAD_STATE_LEN(1)];			/**< Estado do biquad */
+#endif
+	uint16_t last;						/**< Última saída, em mV */
+};
+
+/** @brief Inicializa a etapa de um canal
+ *
+ * @return 0 em caso de sucesso, código de erro negativo caso contrário.
+ */
+int filter_block_init(struct filter_block *f);
+
+/** @brief Filtra n amostras em mV de um canal, em blocos de até FILTER_BLOCK_SIZE
+ *
+ * @param f Etapa do canal.
+ * @param in Primeira amostra.
+ * @param out Destino das saídas, com o mesmo espaçamento que in (pode ser
+ * igual a in), ou NULL se só interessar a última.
+ * @param stride Distância entre amostras consecutivas do canal em in e out
+ * (ADC_NUM_CHANNELS para um buffer de varrimentos).
+ * @param n Número de amostras.
+ * @return Saída correspondente à última amostra, em mV.
+ *
+ * Os buffers de trabalho são estáticos, partilhados por todos os canais:
+ * só uma thread de cada vez pode filtrar (no pipeline, a etapa FILTRO).
+ */
+uint16_t filter_block_run(struct filter_block *f, const uint16_t *in, uint16_t *out, size_t stride,
+			  size_t n);
+
+#endif /* FILTER_BLOCK_H */
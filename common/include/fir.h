@@ -0,0 +1,46 @@
+/*
+ * Filtro FIR
+ */
+
+#ifndef FIR_H
+#define FIR_H
+
+#include <zephyr.h>
+
+#define FIR_BUF_LEN(size) (size) /**< Elementos de memória de trabalho para size coeficientes */
+
+/** @brief Estado do filtro */
+struct fir {
+	uint16_t *window;	/**< Linha de atraso circular, fornecida pelo chamador */
+	const int16_t *coeffs;	/**< Coeficientes em Q15, ou NULL para a janela triangular */
+	uint16_t size;		/**< Número de coeficientes */
+	uint16_t idx;		/**< Próxima posição a escrever */
+	uint32_t tri_sum;	/**< Soma dos pesos da janela triangular */
+};
+
+/** @brief Inicializa o filtro com a linha de atraso a zeros
+ *
+ * Por omissão usa pesos triangulares (Bartlett), min(k + 1, size - k),
+ * normalizados para ganho unitário em DC: um passa-baixo com lóbulos
+ * laterais mais baixos que a média móvel da mesma janela.
+ *
+ * @param f Filtro.
+ * @param buf Memória de trabalho com FIR_BUF_LEN(size) elementos.
+ * @param size Número de coeficientes.
+ */
+void fir_init(struct fir *f, uint16_t *buf, uint16_t size);
+
+/** @brief Substitui os pesos triangulares por coeficientes próprios
+ *
+ * @param f Filtro.
+ * @param coeffs size coeficientes em Q15, h[0] aplicado à amostra mais recente.
+ */
+void fir_set_coeffs(struct fir *f, const int16_t *coeffs);
+
+/** @brief Introduz uma amostra na linha de atraso */
+void fir_push(struct fir *f, uint16_t sample);
+
+/** @brief Saída do filtro, limitada a 0..UINT16_MAX */
+uint16_t fir_output(const struct fir *f);
+
+#endif /* FIR_H */
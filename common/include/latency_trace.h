@@ -0,0 +1,82 @@
+/*
+ * Traço de latência do pipeline, da conversão da ADC à escrita no PWM
+ */
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <zephyr.h>
+
+/* Four sub-buckets (two bits) per power of two: every bucket is at most 25% wide */
+#define LATENCY_HIST_BUCKETS 124 /**< Classes do histograma de 32 bits */
+
+/** @brief Instantes (cycles_now()) de um bloco ao longo do pipeline */
+struct trace_entry {
+	uint32_t t_adc;		/**< Fim da conversão da ADC */
+	uint32_t t_filter_in;	/**< Entrada na etapa FILTRO */
+	uint32_t t_filter_out;	/**< Saída da etapa FILTRO */
+	uint32_t t_pwm;		/**< Fim da escrita no PWM */
+};
+
+/** @brief Troços medidos entre dois instantes de trace_entry */
+enum trace_span {
+	TRACE_ADC_TO_FILTER,	/**< t_adc -> t_filter_in: transporte e ativação */
+	TRACE_FILTER,		/**< t_filter_in -> t_filter_out: filtro */
+	TRACE_FILTER_TO_PWM,	/**< t_filter_out -> t_pwm: transporte e escrita no PWM */
+	TRACE_END_TO_END,	/**< t_adc -> t_pwm */
+	TRACE_SPANS,
+};
+
+/** @brief Mínimo, média, máximo e histograma logarítmico de um troço (ciclos) */
+struct latency_hist {
+	uint32_t min;		/**< Menor latência */
+	uint32_t max;		/**< Maior latência */
+	uint64_t sum;		/**< Soma das latências */
+	uint32_t count;		/**< Blocos medidos */
+	uint32_t bucket[LATENCY_HIST_BUCKETS]; /**< Blocos em cada classe */
+};
+
+/** @brief Regista um bloco que chegou ao PWM
+ *
+ * Guarda os instantes no anel de CONFIG_APP_TRACE_RING_SIZE entradas (a
+ * mais antiga é reescrita) e acumula cada troço no seu histograma. Só a
+ * etapa PWM chama esta função.
+ */
+void latency_trace_record(const struct trace_entry *e);
+
+/** @brief Percentil de um troço
+ *
+ * @param span Troço.
+ * @param pct Percentil (0 a 100).
+ * @return Limite superior (ns) da classe do histograma onde está o
+ *         percentil, nunca acima do máximo observado; 0 sem medições.
+ */
+uint32_t latency_trace_percentile(enum trace_span span, uint32_t pct);
+
+/** @brief Recomeça os histogramas, p.ex. entre dois passos de uma medição
+ *
+ * Não é sincronizada com latency_trace_record(): um bloco registado
+ * durante a chamada pode ficar contado só em parte.
+ */
+void latency_trace_reset(void);
+
+/** @brief Blocos registados com t_adc a 0 desde o último latency_trace_reset()
+ *
+ * Um bloco assim não passou pela etapa ADC com os tempos (p.ex. um
+ * transporte que não os transporta) e as suas latências não têm sentido.
+ */
+uint32_t latency_trace_unstamped(void);
+
+/** @brief Nome de um troço, como nos relatórios */
+const char *latency_trace_span_name(enum trace_span span);
+
+/** @brief Copia as últimas entradas do anel, da mais antiga para a mais recente
+ *
+ * @return Entradas copiadas (no máximo n).
+ */
+int latency_trace_last(struct trace_entry *out, int n);
+
+/** @brief Imprime min/avg/max e os percentis 50, 90 e 99 de cada troço em ns */
+void latency_trace_report(void);
+
+#endif /* LATENCY_TRACE_H */
@@ -0,0 +1,38 @@
+/*
+ * Mediana numa janela deslizante
+ */
+
+#ifndef MEDIAN_H
+#define MEDIAN_H
+
+#include <zephyr.h>
+
+#define MEDIAN_BUF_LEN(size) (2 * (size)) /**< Elementos de memória de trabalho: janela circular e cópia ordenada */
+
+/** @brief Estado do filtro */
+struct median {
+	uint16_t *window;	/**< Janela circular, por ordem de chegada */
+	uint16_t *sorted;	/**< As mesmas amostras, por ordem crescente */
+	uint16_t size;		/**< Tamanho da janela */
+	uint16_t idx;		/**< Próxima posição a escrever */
+};
+
+/** @brief Inicializa o filtro com a janela a zeros
+ *
+ * @param f Filtro.
+ * @param buf Memória de trabalho com MEDIAN_BUF_LEN(size) elementos.
+ * @param size Tamanho da janela.
+ */
+void median_init(struct median *f, uint16_t *buf, uint16_t size);
+
+/** @brief Introduz uma amostra, substituindo a mais antiga
+ *
+ * Retira a amostra mais antiga da cópia ordenada e insere a nova
+ * (procura binária e deslocamento, O(size)).
+ */
+void median_push(struct median *f, uint16_t sample);
+
+/** @brief Mediana da janela (média das duas centrais se size for par) */
+uint16_t median_output(const struct median *f);
+
+#endif /* MEDIAN_H */
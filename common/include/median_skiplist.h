@@ -0,0 +1,56 @@
+/*
+ * Mediana numa janela deslizante sobre uma skiplist indexável
+ */
+
+#ifndef MEDIAN_SKIPLIST_H
+#define MEDIAN_SKIPLIST_H
+
+#include <zephyr.h>
+
+#define MEDIAN_SKIPLIST_LEVELS 6 /**< Níveis da skiplist (p = 1/4, eficiente até ~4^6 amostras) */
+
+/** @brief Nó da skiplist; só tem campos de 16 bits, para viver num buffer de uint16_t */
+struct median_skiplist_node {
+	uint16_t value;					/**< Amostra */
+	uint16_t levels;				/**< Níveis em que o nó está ligado */
+	uint16_t next[MEDIAN_SKIPLIST_LEVELS];		/**< Índice do nó seguinte em cada nível */
+	uint16_t width[MEDIAN_SKIPLIST_LEVELS];		/**< Posições saltadas por cada ligação */
+};
+
+/** @brief Elementos de memória de trabalho: janela circular, cabeça e um nó por amostra */
+#define MEDIAN_SKIPLIST_BUF_LEN(size) \
+	((size) + ((size) + 1) * (sizeof(struct median_skiplist_node) / sizeof(uint16_t)))
+
+/** @brief Estado do filtro */
+struct median_skiplist {
+	uint16_t *window;			/**< Janela circular, por ordem de chegada */
+	struct median_skiplist_node *nodes;	/**< Arena de nós; o nó 0 é a cabeça */
+	uint16_t size;				/**< Tamanho da janela */
+	uint16_t idx;				/**< Próxima posição a escrever */
+	uint32_t seed;				/**< Estado do gerador dos níveis dos nós */
+};
+
+/** @brief Inicializa o filtro com a janela a zeros
+ *
+ * Toda a memória vem de buf: não há alocação dinâmica.
+ *
+ * @param f Filtro.
+ * @param buf Memória de trabalho com MEDIAN_SKIPLIST_BUF_LEN(size) elementos.
+ * @param size Tamanho da janela (até 65534).
+ */
+void median_skiplist_init(struct median_skiplist *f, uint16_t *buf, uint16_t size);
+
+/** @brief Introduz uma amostra, substituindo a mais antiga
+ *
+ * Retira da skiplist o nó da amostra mais antiga e reutiliza-o para a
+ * nova (O(log size) em média).
+ */
+void median_skiplist_push(struct median_skiplist *f, uint16_t sample);
+
+/** @brief Mediana da janela (média das duas centrais se size for par)
+ *
+ * Procura por posição usando as larguras das ligações (O(log size)).
+ */
+uint16_t median_skiplist_output(const struct median_skiplist *f);
+
+#endif /* MEDIAN_SKIPLIST_H */
@@ -0,0 +1,34 @@
+/*
+ * Média móvel simples
+ */
+
+#ifndef MOVING_AVG_H
+#define MOVING_AVG_H
+
+#include <zephyr.h>
+
+#define MOVING_AVG_BUF_LEN(size) (size) /**< Elementos de memória de trabalho para uma janela de size amostras */
+
+/** @brief Estado do filtro */
+struct moving_avg {
+	uint16_t *window;	/**< Janela circular de amostras, fornecida pelo chamador */
+	uint16_t size;		/**< Tamanho da janela */
+	uint16_t idx;		/**< Próxima posição a escrever */
+	uint32_t sum;		/**< Soma corrente da janela */
+};
+
+/** @brief Inicializa o filtro com a janela a zeros
+ *
+ * @param f Filtro.
+ * @param buf Memória de trabalho com MOVING_AVG_BUF_LEN(size) elementos.
+ * @param size Tamanho da janela.
+ */
+void moving_avg_init(struct moving_avg *f, uint16_t *buf, uint16_t size);
+
+/** @brief Introduz uma amostra, substituindo a mais antiga (O(1)) */
+void moving_avg_push(struct moving_avg *f, uint16_t sample);
+
+/** @brief Média das amostras da janela */
+uint16_t moving_avg_output(const struct moving_avg *f);
+
+#endif /* MOVING_AVG_H */
@@ -0,0 +1,66 @@
+/*
+ * Ativação periódica sem deriva, baseada num k_timer
+ */
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include <zephyr.h>
+
+/** @brief Estado de uma tarefa periódica */
+struct periodic {
+	struct k_timer *timer;		/**< Timer que marca os instantes de ativação */
+	int64_t origin;			/**< Instante (ticks) da ativação 0; fixa a fase */
+	int64_t period;			/**< Período em ticks */
+	uint32_t index;			/**< Índice da última ativação servida */
+	uint32_t activations;		/**< Ativações servidas */
+	uint32_t missed;		/**< Ativações perdidas por overrun */
+	uint32_t max_lateness_us;	/**< Maior atraso observado face ao instante nominal */
+	uint64_t sum_lateness_us;	/**< Soma dos atrasos, para o atraso médio */
+};
+
+/** @brief Arranca a tarefa periódica
+ *
+ * A ativação 0 é o instante corrente; as seguintes ocorrem em
+ * origin + k * period, independentemente do tempo de execução da tarefa.
+ *
+ * @param p Estado da tarefa.
+ * @param timer Timer a usar (inicializado aqui).
+ * @param period_ms Período em milisegundos.
+ */
+void periodic_start(struct periodic *p, struct k_timer *timer, uint32_t period_ms);
+
+/** @brief Muda o período de uma tarefa já arrancada
+ *
+ * A fase recomeça no instante corrente, que passa a ser a ativação 0;
+ * os contadores e os atrasos acumulados mantêm-se.
+ *
+ * @param p Estado da tarefa.
+ * @param period_ms Novo período em milisegundos.
+ */
+void periodic_set_period(struct periodic *p, uint32_t period_ms);
+
+/** @brief Bloqueia até à próxima ativação
+ *
+ * Se a tarefa excedeu o período, as ativações entretanto expiradas são
+ * contabilizadas como perdidas e a tarefa é libertada de imediato, sem
+ * alterar a fase das ativações seguintes.
+ *
+ * @return Número de ativações perdidas desde a chamada anterior.
+ */
+uint32_t periodic_wait(struct periodic *p);
+
+/** @brief Instante (ticks, como k_uptime_ticks()) da ativação seguinte à última servida */
+static inline int64_t periodic_next_release(const struct periodic *p)
+{
+	return p->origin + (int64_t)(p->index + 1) * p->period;
+}
+
+/** @brief Imprime ativações, ativações perdidas e atraso médio/máximo
+ *
+ * @param p Estado da tarefa.
+ * @param name Nome da tarefa usado no relatório.
+ */
+void periodic_report(const struct periodic *p, const char *name);
+
+#endif /* PERIODIC_H */
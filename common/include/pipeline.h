@@ -0,0 +1,49 @@
+/*
+ * Pipeline ADC -> filtro -> PWM, partilhado pelas aplicações Fifo e Semaphores
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <zephyr.h>
+
+#include "periodic.h"
+#include "transport.h"
+
+extern struct periodic adc_periodic; /**< Fase, ativações e ativações perdidas da thread_ADC */
+extern transport_t adc_link; /**< Ligação thread_ADC -> thread_FILTRO */
+extern transport_t pwm_link; /**< Ligação thread_FILTRO -> thread_PWM */
+
+/** @brief Contadores acumulados desde o arranque do pipeline */
+struct pipeline_counters {
+	uint32_t samples;	/**< Varrimentos adquiridos pela etapa ADC */
+	uint32_t blocks;	/**< Blocos filtrados */
+	uint32_t drops;		/**< Blocos descartados ou substituídos nas duas ligações */
+	uint32_t overruns;	/**< Ativações periódicas perdidas pela etapa ADC */
+};
+
+/** @brief Thread ADC: periódica, adquire uma rajada e envia-a à thread_FILTRO */
+void thread_ADC_code(void *argA, void *argB, void *argC);
+
+/** @brief Thread FILTRO: esporádica, filtra cada bloco recebido e envia-o à thread_PWM */
+void thread_FILTRO_code(void *argA, void *argB, void *argC);
+
+/** @brief Thread PWM: esporádica, atualiza o duty-cycle de cada canal */
+void thread_PWM_code(void *argA, void *argB, void *argC);
+
+/** @brief Lê os contadores do pipeline
+ *
+ * Leituras simples, sem locks: cada contador é coerente, mas os quatro
+ * podem vir de instantes ligeiramente diferentes.
+ */
+void pipeline_counters_get(struct pipeline_counters *c);
+
+/** @brief Inicializa as ligações e cria as threads do pipeline
+ *
+ * As duas ligações usam o transporte escolhido em APP_TRANSPORT. Com
+ * APP_PIPELINE_WORKQ arranca antes a work queue e o timer da etapa ADC.
+ * Começa por publicar a configuração inicial (pipeline_cfg.h).
+ */
+void pipeline_start(void);
+
+#endif /* PIPELINE_H */
@@ -0,0 +1,53 @@
+/*
+ * Parâmetros do pipeline alteráveis em tempo de execução
+ */
+
+#ifndef PIPELINE_CFG_H
+#define PIPELINE_CFG_H
+
+#include <zephyr.h>
+
+/** @brief Parâmetros lidos pelas etapas a cada ativação */
+struct pipeline_cfg {
+	uint32_t period_ms;	/**< Período de amostragem da etapa ADC */
+	uint16_t window;	/**< Janela do filtro (1..APP_FILTER_WINDOW amostras) */
+	uint16_t band_pct;	/**< Banda da média aparada, em % da média */
+	uint32_t pwm_period_us;	/**< Período do PWM */
+	uint32_t gen;		/**< Geração da cópia; só pipeline_cfg_refresh() a altera */
+};
+
+/** @brief Publica a configuração inicial, antes de as etapas arrancarem
+ *
+ * Não valida c: são os valores de compilação do pipeline.
+ */
+void pipeline_cfg_init(const struct pipeline_cfg *c);
+
+/** @brief Atualiza uma cópia local com a última configuração publicada
+ *
+ * Não usa locks e não espera por uma escrita em curso: como em
+ * transport_sem, a configuração está em dois buffers alternados por
+ * geração e a cópia só é repetida se uma escrita começar a reescrever o
+ * buffer a meio da cópia. Se c já tiver a última geração só lê o
+ * contador, pelo que pode ser chamada a cada ativação de uma etapa.
+ * Uma cópia a zeros recebe sempre a configuração corrente.
+ *
+ * @param c Cópia da etapa.
+ * @return true se c mudou.
+ */
+bool pipeline_cfg_refresh(struct pipeline_cfg *c);
+
+/** @brief Valida e publica uma nova configuração
+ *
+ * As escritas (shell) são serializadas entre si por um k_mutex; as
+ * leituras nunca o tomam.
+ *
+ * @param c Nova configuração (gen é ignorado).
+ * @retval 0 Publicada.
+ * @retval -EINVAL Valor fora dos limites.
+ * @retval -ENOTSUP Parâmetro fixo nesta configuração (período em modo
+ *         contínuo ou no callback da ADC, janela com APP_FILTER_BLOCK,
+ *         banda com outro filtro que não a média aparada).
+ */
+int pipeline_cfg_set(const struct pipeline_cfg *c);
+
+#endif /* PIPELINE_CFG_H */
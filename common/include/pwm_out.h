@@ -0,0 +1,25 @@
+/*
+ * Saída PWM do pipeline, um pino por canal da ADC
+ *
+ * Há duas implementações: o PWM da placa (pwm_out.c) e, nas placas sem
+ * PWM (native_posix, qemu_cortex_m3), um PWM simulado que regista cada
+ * atualização (pwm_stub.c, APP_PWM_STUB).
+ */
+
+#ifndef PWM_OUT_H
+#define PWM_OUT_H
+
+#include <zephyr.h>
+
+/** @brief Liga-se ao PWM; sem PWM o duty-cycle é só impresso */
+void pwm_out_init(void);
+
+/** @brief Atualiza o pino do canal c
+ *
+ * @param c Canal da ADC (0..ADC_NUM_CHANNELS - 1).
+ * @param period_us Período do PWM.
+ * @param pulse_us Duração do impulso.
+ */
+void pwm_out_set(int c, uint32_t period_us, uint32_t pulse_us);
+
+#endif /* PWM_OUT_H */
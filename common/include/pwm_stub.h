@@ -0,0 +1,41 @@
+/*
+ * PWM simulado: regista cada atualização do duty-cycle
+ *
+ * Substitui o PWM da placa quando ela não o tem (native_posix,
+ * qemu_cortex_m3) e permite verificar a saída do pipeline sem
+ * hardware: as últimas APP_PWM_STUB_RING_SIZE atualizações ficam num
+ * anel e cada uma pode ainda ser entregue a um callback.
+ */
+
+#ifndef PWM_STUB_H
+#define PWM_STUB_H
+
+#include <zephyr.h>
+
+/** @brief Uma atualização do PWM */
+struct pwm_stub_event {
+	uint32_t t;		/**< cycles_now() da atualização */
+	uint16_t channel;	/**< Canal da ADC que a originou */
+	uint32_t period_us;	/**< Período do PWM */
+	uint32_t pulse_us;	/**< Duração do impulso */
+};
+
+/** @brief Chamada em cada atualização, no contexto da etapa PWM */
+typedef void (*pwm_stub_callback_t)(const struct pwm_stub_event *e, void *user_data);
+
+/** @brief Atualizações registadas desde o arranque */
+uint32_t pwm_stub_count(void);
+
+/** @brief Copia as últimas atualizações do anel, da mais antiga para a mais recente
+ *
+ * @return Atualizações copiadas (no máximo n).
+ */
+int pwm_stub_last(struct pwm_stub_event *out, int n);
+
+/** @brief Instala (ou, com NULL, retira) o callback de cada atualização
+ *
+ * A etapa PWM lê-o sem locks: deve ser instalado antes de pipeline_start().
+ */
+void pwm_stub_set_callback(pwm_stub_callback_t cb, void *user_data);
+
+#endif /* PWM_STUB_H */
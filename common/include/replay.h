@@ -0,0 +1,38 @@
+/*
+ * Reprodução de gravações da entrada analógica através do pipeline (native_posix)
+ *
+ * Com --replay-in=<ficheiro> cada canal da ADC emulada lê, conversão a
+ * conversão, os valores gravados, e a thread_ADC adquire o varrimento
+ * seguinte logo que o anterior chega ao PWM, em vez de a cada
+ * thread_ADC_period ms. O duty-cycle de cada bloco é escrito em
+ * --replay-out e, no fim, comparado com --replay-golden.
+ *
+ * Entrada: um varrimento por linha, um valor em mV por canal separado
+ * por espaços ou vírgulas; as linhas começadas por '#' são ignoradas.
+ * Saída: uma linha por bloco, o duty-cycle de cada canal.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <zephyr.h>
+
+/** @brief true se foi dado --replay-in e a gravação foi carregada */
+bool replay_active(void);
+
+/** @brief Impõe a gravação às entradas da ADC emulada
+ *
+ * Chamada pela thread_ADC depois de adc_acq_init(); não faz nada sem
+ * --replay-in.
+ */
+void replay_start(void);
+
+/** @brief Espera que o último varrimento enviado chegue ao PWM
+ *
+ * Depois do último varrimento da gravação imprime os varrimentos por
+ * segundo (tempo real do host), compara a saída com --replay-golden e
+ * termina o processo: 0 se a saída for igual, 1 caso contrário.
+ */
+void replay_next(void);
+
+#endif /* REPLAY_H */
@@ -0,0 +1,75 @@
+/*
+ * Prioridades deadline-monotonic e análise do tempo de resposta das etapas
+ */
+
+#ifndef SCHED_RTA_H
+#define SCHED_RTA_H
+
+#include <zephyr.h>
+#include <limits.h>
+
+#include "cycles.h"
+
+#define RTA_PRIO_ISR INT_MIN /**< Prioridade de uma etapa que corre em interrupção */
+
+/** @brief Uma etapa do pipeline vista como tarefa periódica */
+struct rta_task {
+	const char *name;	/**< Nome usado no relatório */
+	uint32_t period_us;	/**< Período (ou intervalo mínimo entre ativações), T */
+	uint32_t deadline_us;	/**< Deadline relativa à ativação, D */
+	int prio;		/**< Prioridade Zephyr (menor = mais prioritária) */
+	uint32_t wcet;		/**< Maior tempo de execução medido (ciclos), C */
+	uint32_t start;		/**< cycles_now() no início da ativação corrente */
+};
+
+/** @brief Início de uma ativação da etapa */
+static inline void rta_job_begin(struct rta_task *t)
+{
+	t->start = cycles_now();
+}
+
+/** @brief Fim de uma ativação da etapa: atualiza o WCET medido
+ *
+ * O tempo medido é o decorrido desde rta_job_begin(), pelo que inclui as
+ * preempções e as interrupções; é um majorante do tempo de execução.
+ */
+static inline void rta_job_end(struct rta_task *t)
+{
+	uint32_t c = cycles_now() - t->start;
+
+	if (c > t->wcet) {
+		t->wcet = c;
+	}
+}
+
+/** @brief Atribui prioridades deadline-monotonic
+ *
+ * A tarefa com a menor deadline fica com a prioridade base_prio, a
+ * seguinte com base_prio + 1, etc. As tarefas com RTA_PRIO_ISR não são
+ * alteradas. n <= 32.
+ */
+void rta_assign_dm(struct rta_task *t, int n, int base_prio);
+
+/** @brief Análise do tempo de resposta com prioridades fixas
+ *
+ * R = C + soma, para as outras tarefas com prioridade maior ou igual,
+ * de ceil(R / Tj) * Cj, iterado até convergir. As tarefas com a mesma
+ * prioridade não se preemptam (sem time slicing) e contam como
+ * interferência. Imprime C, D, prioridade e R de cada tarefa e, como
+ * limite da latência de ponta a ponta da cadeia, a soma dos R.
+ *
+ * @return Limite de ponta a ponta (us), 0 se alguma tarefa falhar a deadline.
+ */
+uint32_t rta_report(const struct rta_task *t, int n);
+
+/** @brief Teste de escalonabilidade EDF
+ *
+ * Imprime a utilização e a densidade (soma de C / min(D, T)). Com
+ * densidade <= 1 todas as ativações cumprem a deadline e a soma das D é
+ * um limite da latência de ponta a ponta da cadeia.
+ *
+ * @return Limite de ponta a ponta (us), 0 se o teste falhar.
+ */
+uint32_t rta_report_edf(const struct rta_task *t, int n);
+
+#endif /* SCHED_RTA_H */
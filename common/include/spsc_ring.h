@@ -0,0 +1,64 @@
+/*
+ * Anel sem locks para um produtor e um consumidor
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <zephyr.h>
+#include <sys/atomic.h>
+
+/** @brief Estado do anel
+ *
+ * head só é escrito pelo consumidor e tail só pelo produtor; ambos são
+ * contadores livres (o índice é o contador módulo a capacidade), pelo
+ * que ocupação = tail - head, mesmo depois de darem a volta.
+ */
+struct spsc_ring {
+	uint8_t *buf;		/**< Memória dos elementos */
+	size_t elem_size;	/**< Tamanho de cada elemento (bytes) */
+	uint32_t mask;		/**< Capacidade - 1 (a capacidade é potência de 2) */
+	atomic_t head;		/**< Elementos já retirados */
+	atomic_t tail;		/**< Elementos já inseridos */
+	struct k_sem *wake;	/**< Semáforo dado quando o anel deixa de estar vazio, ou NULL */
+};
+
+/** @brief Inicializa o anel vazio
+ *
+ * @param r Anel.
+ * @param buf Memória para capacity elementos.
+ * @param elem_size Tamanho de cada elemento (bytes).
+ * @param capacity Número de elementos; tem de ser potência de 2.
+ * @param wake Semáforo (limite 1) dado pelo produtor quando o anel passa
+ * de vazio a não vazio, ou NULL se o consumidor não precisar de ser
+ * acordado. Também pode ser esperado com k_poll() (K_POLL_TYPE_SEM_AVAILABLE).
+ * @return 0 em caso de sucesso, -EINVAL se capacity não for potência de 2.
+ */
+int spsc_ring_init(struct spsc_ring *r, void *buf, size_t elem_size, uint32_t capacity,
+		   struct k_sem *wake);
+
+/** @brief Insere n elementos, todos ou nenhum (só o produtor)
+ *
+ * @return n se couberem, 0 se o anel não tiver espaço para todos.
+ */
+uint32_t spsc_ring_put(struct spsc_ring *r, const void *data, uint32_t n);
+
+/** @brief Retira até max elementos de uma vez (só o consumidor)
+ *
+ * @return Número de elementos copiados para data (0 se o anel estiver vazio).
+ */
+uint32_t spsc_ring_get(struct spsc_ring *r, void *data, uint32_t max);
+
+/** @brief Espera que o anel tenha elementos (só o consumidor)
+ *
+ * @return 0 se houver elementos, -EAGAIN se o tempo esgotar.
+ */
+int spsc_ring_wait(struct spsc_ring *r, k_timeout_t timeout);
+
+/** @brief Número de elementos no anel */
+static inline uint32_t spsc_ring_count(struct spsc_ring *r)
+{
+	return (uint32_t)atomic_get(&r->tail) - (uint32_t)atomic_get(&r->head);
+}
+
+#endif /* SPSC_RING_H */
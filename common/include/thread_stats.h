@@ -0,0 +1,20 @@
+/*
+ * Tempo de CPU e ocupação máxima da stack de cada thread
+ */
+
+#ifndef THREAD_STATS_H
+#define THREAD_STATS_H
+
+#include <zephyr.h>
+
+/** @brief Imprime a utilização do CPU e da stack de cada thread
+ *
+ * Para cada thread: percentagem do CPU desde o relatório anterior (ou
+ * desde o arranque) e bytes da stack já usados (high-water) face ao seu
+ * tamanho. Termina com a percentagem de tempo na thread idle. Pode ser
+ * chamada periodicamente e a pedido (pipeline threads), de threads
+ * diferentes: as chamadas são serializadas por um k_mutex.
+ */
+void thread_stats_report(void);
+
+#endif /* THREAD_STATS_H */
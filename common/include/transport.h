@@ -0,0 +1,250 @@
+/*
+ * Transporte de blocos de amostras entre as threads do pipeline
+ *
+ * Todos os transportes têm a mesma interface: transport_<nome>_init(t),
+ * _alloc(t) e _send(t, b) do lado do produtor, _recv(t, timeout) e
+ * _release(t, b) do lado do consumidor. Cada ligação tem um só produtor
+ * e um só consumidor. No fim deste ficheiro transport_t e transport_*()
+ * são ligados ao transporte escolhido em APP_TRANSPORT, como em filter.h.
+ */
+
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <zephyr.h>
+
+#include "adc_acq.h"
+#include "spsc_ring.h"
+
+/** @brief Bloco de amostras trocado entre duas threads do pipeline */
+struct sample_block {
+	uint32_t t_adc;		/**< cycles_now() no fim da conversão do último varrimento */
+	uint32_t t_filter_in;	/**< cycles_now() à entrada da etapa FILTRO */
+	uint32_t t_filter_out;	/**< cycles_now() à saída da etapa FILTRO */
+	uint32_t stamp;		/**< cycles_now() quando o produtor enviou o bloco */
+	uint16_t count;		/**< Varrimentos válidos em data */
+	uint16_t data[ADC_BURST_SAMPLES][ADC_NUM_CHANNELS]; /**< Valor (mV) de cada canal em cada varrimento */
+};
+
+/** @brief Contadores de sobrecarga de uma ligação (campo stats de cada transporte) */
+struct transport_stats {
+	uint32_t dropped;	/**< Blocos descartados, o novo ou o mais antigo conforme a política */
+	uint32_t coalesced;	/**< Blocos substituídos por um mais recente antes de serem lidos */
+	uint32_t high_water;	/**< Maior ocupação observada (blocos; varrimentos no anel) */
+};
+
+/** @brief Imprime os contadores de uma ligação */
+void transport_report(const struct transport_stats *s, const char *name);
+
+/*
+ * Produtor: b = _alloc(t) devolve o bloco a preencher (NULL se não houver
+ * nenhum livre) e _send(t, b) entrega-o. Só bloqueiam com a política
+ * APP_TRANSPORT_OVERLOAD_BLOCK; caso contrário um bloco que não possa ser
+ * entregue é descartado (_send() devolve um erro negativo) e contado em
+ * stats. Consumidor: _recv() espera por um bloco (NULL se o tempo
+ * esgotar) que fica do consumidor até _release().
+ */
+
+#if defined(CONFIG_APP_TRANSPORT_LIB_FIFO)
+/** @brief Bloco do pool de transport_fifo */
+struct transport_fifo_item {
+	void *fifo_reserved;		/**< 1st word reserved for use by fifo */
+	struct sample_block block;	/**< Bloco entregue ao produtor e ao consumidor */
+};
+
+/* Queued blocks, plus the one the consumer holds, the one being written and a pending one */
+#define TRANSPORT_FIFO_BLOCKS (CONFIG_APP_TRANSPORT_DEPTH + 3) /**< Blocos no pool de cada ligação */
+
+/** @brief k_fifo limitado a APP_TRANSPORT_DEPTH blocos de um k_mem_slab, passados por ponteiro
+ *
+ * Com a fila cheia aplica a política APP_TRANSPORT_OVERLOAD. A fila, a
+ * ocupação e o bloco pendente só mudam com lock tomado, pelo que o
+ * produtor vê a ocupação real quando decide descartar ou substituir um
+ * bloco; o consumidor espera em items e não no k_fifo.
+ */
+struct transport_fifo {
+	struct k_fifo fifo;		/**< Blocos enviados */
+	struct k_mem_slab slab;		/**< Pool de blocos */
+	struct k_spinlock lock;		/**< Protege fifo, depth, pending e stats.high_water */
+	struct k_sem items;		/**< Dado a cada bloco posto na fila; pode sobrar depois de um descarte */
+	uint32_t depth;			/**< Blocos na fila */
+	struct k_sem space;		/**< Lugares livres na fila (política BLOCK) */
+	struct transport_fifo_item *pending; /**< Bloco à espera de lugar na fila (política COALESCE) */
+	struct transport_stats stats;	/**< Contadores de sobrecarga */
+	struct transport_fifo_item mem[TRANSPORT_FIFO_BLOCKS]; /**< Memória do pool */
+};
+
+int transport_fifo_init(struct transport_fifo *t);
+struct sample_block *transport_fifo_alloc(struct transport_fifo *t);
+int transport_fifo_send(struct transport_fifo *t, struct sample_block *b);
+struct sample_block *transport_fifo_recv(struct transport_fifo *t, k_timeout_t timeout);
+void transport_fifo_release(struct transport_fifo *t, struct sample_block *b);
+#endif
+
+#if defined(CONFIG_APP_TRANSPORT_LIB_SEM)
+/** @brief Variável partilhada com gerações e semáforo de limite 1
+ *
+ * O produtor escreve alternadamente em buf[0] e buf[1] e seq conta as
+ * transições: ímpar enquanto escreve, par depois de publicar. A geração
+ * g = seq / 2 está em buf[g & 1]. O consumidor copia a última geração
+ * publicada sem locks e repete a cópia só se o produtor tiver entretanto
+ * começado a reescrever esse buffer; nunca espera por uma escrita em
+ * curso. Um bloco novo continua a substituir o anterior, mas as
+ * gerações saltadas são contadas em stats.coalesced.
+ */
+struct transport_sem {
+	struct k_sem sem;		/**< Dado a cada bloco publicado */
+	atomic_t seq;			/**< 2 * geração publicada, +1 durante uma escrita */
+	struct sample_block buf[2];	/**< Buffers do produtor, alternados por geração */
+	struct sample_block out;	/**< Cópia consistente do consumidor */
+	uint32_t last;			/**< Última geração lida pelo consumidor */
+	uint32_t retries;		/**< Cópias repetidas por terem sido apanhadas a meio de uma escrita */
+	struct transport_stats stats;	/**< Gerações saltadas em stats.coalesced */
+};
+
+int transport_sem_init(struct transport_sem *t);
+struct sample_block *transport_sem_alloc(struct transport_sem *t);
+int transport_sem_send(struct transport_sem *t, struct sample_block *b);
+struct sample_block *transport_sem_recv(struct transport_sem *t, k_timeout_t timeout);
+void transport_sem_release(struct transport_sem *t, struct sample_block *b);
+#endif
+
+#if defined(CONFIG_APP_TRANSPORT_LIB_MSGQ)
+/** @brief k_msgq de blocos, copiados na entrada e na saída */
+struct transport_msgq {
+	struct k_msgq msgq;		/**< Fila de blocos */
+	struct sample_block in;		/**< Bloco do produtor */
+	struct sample_block out;	/**< Bloco do consumidor */
+	struct transport_stats stats;	/**< Contadores de sobrecarga */
+	char mem[CONFIG_APP_TRANSPORT_DEPTH * sizeof(struct sample_block)] __aligned(4); /**< Memória da fila */
+};
+
+int transport_msgq_init(struct transport_msgq *t);
+struct sample_block *transport_msgq_alloc(struct transport_msgq *t);
+int transport_msgq_send(struct transport_msgq *t, struct sample_block *b);
+struct sample_block *transport_msgq_recv(struct transport_msgq *t, k_timeout_t timeout);
+void transport_msgq_release(struct transport_msgq *t, struct sample_block *b);
+#endif
+
+#if defined(CONFIG_APP_TRANSPORT_LIB_PIPE)
+/** @brief k_pipe de bytes, escrito e lido um bloco inteiro de cada vez */
+struct transport_pipe {
+	struct k_pipe pipe;		/**< Pipe */
+	struct sample_block in;		/**< Bloco do produtor */
+	struct sample_block out;	/**< Bloco do consumidor */
+	struct transport_stats stats;	/**< Contadores de sobrecarga */
+	uint8_t mem[CONFIG_APP_TRANSPORT_DEPTH * sizeof(struct sample_block)]; /**< Buffer do pipe */
+};
+
+int transport_pipe_init(struct transport_pipe *t);
+struct sample_block *transport_pipe_alloc(struct transport_pipe *t);
+int transport_pipe_send(struct transport_pipe *t, struct sample_block *b);
+struct sample_block *transport_pipe_recv(struct transport_pipe *t, k_timeout_t timeout);
+void transport_pipe_release(struct transport_pipe *t, struct sample_block *b);
+#endif
+
+#if defined(CONFIG_APP_TRANSPORT_LIB_POLL)
+/** @brief Bloco partilhado e k_poll_signal; um bloco novo reescreve o anterior */
+struct transport_poll {
+	struct k_poll_signal signal;	/**< Levantado a cada bloco enviado */
+	struct k_poll_event event;	/**< Evento esperado pelo consumidor */
+	struct sample_block shared;	/**< Variável partilhada */
+	struct transport_stats stats;	/**< Blocos reescritos antes de lidos em stats.coalesced */
+};
+
+int transport_poll_init(struct transport_poll *t);
+struct sample_block *transport_poll_alloc(struct transport_poll *t);
+int transport_poll_send(struct transport_poll *t, struct sample_block *b);
+struct sample_block *transport_poll_recv(struct transport_poll *t, k_timeout_t timeout);
+void transport_poll_release(struct transport_poll *t, struct sample_block *b);
+#endif
+
+#if defined(CONFIG_APP_TRANSPORT_LIB_RING)
+/** @brief Tempos de um bloco enviado para o anel */
+struct transport_ring_hdr {
+	uint32_t end;		/**< Varrimentos escritos no anel até ao fim deste bloco */
+	uint32_t t_adc;		/**< t_adc do bloco */
+	uint32_t t_filter_in;	/**< t_filter_in do bloco */
+	uint32_t t_filter_out;	/**< t_filter_out do bloco */
+	uint32_t stamp;		/**< cycles_now() quando o bloco foi enviado */
+};
+
+/** @brief Anel SPSC de varrimentos; o consumidor retira vários de uma vez
+ *
+ * Os varrimentos não têm tempos próprios: cada envio publica um
+ * transport_ring_hdr num segundo anel, indexado como o primeiro, e o
+ * consumidor entrega os tempos do bloco a que pertence o varrimento mais
+ * antigo que retirou, pelo que a latência medida é a do pior varrimento.
+ */
+struct transport_ring {
+	struct spsc_ring ring;		/**< Anel */
+	struct k_sem wake;		/**< Dado quando o anel deixa de estar vazio */
+	struct transport_ring_hdr hdr[CONFIG_APP_TRANSPORT_RING_SCANS]; /**< Tempos de cada bloco por ler */
+	atomic_t hdr_tail;		/**< Cabeçalhos publicados (só o produtor escreve) */
+	atomic_t hdr_head;		/**< Cabeçalhos já consumidos (só o consumidor escreve) */
+	uint32_t written;		/**< Varrimentos escritos (só o produtor) */
+	uint32_t read;			/**< Varrimentos retirados (só o consumidor) */
+	struct sample_block in;		/**< Bloco do produtor */
+	struct sample_block out;	/**< Bloco do consumidor */
+	struct transport_stats stats;	/**< Contadores de sobrecarga */
+	uint16_t mem[CONFIG_APP_TRANSPORT_RING_SCANS][ADC_NUM_CHANNELS]; /**< Memória do anel */
+};
+
+int transport_ring_init(struct transport_ring *t);
+struct sample_block *transport_ring_alloc(struct transport_ring *t);
+int transport_ring_send(struct transport_ring *t, struct sample_block *b);
+struct sample_block *transport_ring_recv(struct transport_ring *t, k_timeout_t timeout);
+void transport_ring_release(struct transport_ring *t, struct sample_block *b);
+#endif
+
+#if defined(CONFIG_APP_TRANSPORT_SEM)
+typedef struct transport_sem transport_t; /**< Ligação com o transporte escolhido */
+#define TRANSPORT_NAME "k_sem + shared variable" /**< Nome do transporte escolhido */
+#define transport_init transport_sem_init
+#define transport_alloc transport_sem_alloc
+#define transport_send transport_sem_send
+#define transport_recv transport_sem_recv
+#define transport_release transport_sem_release
+#elif defined(CONFIG_APP_TRANSPORT_MSGQ)
+typedef struct transport_msgq transport_t;
+#define TRANSPORT_NAME "k_msgq"
+#define transport_init transport_msgq_init
+#define transport_alloc transport_msgq_alloc
+#define transport_send transport_msgq_send
+#define transport_recv transport_msgq_recv
+#define transport_release transport_msgq_release
+#elif defined(CONFIG_APP_TRANSPORT_PIPE)
+typedef struct transport_pipe transport_t;
+#define TRANSPORT_NAME "k_pipe"
+#define transport_init transport_pipe_init
+#define transport_alloc transport_pipe_alloc
+#define transport_send transport_pipe_send
+#define transport_recv transport_pipe_recv
+#define transport_release transport_pipe_release
+#elif defined(CONFIG_APP_TRANSPORT_POLL)
+typedef struct transport_poll transport_t;
+#define TRANSPORT_NAME "k_poll_signal + shared variable"
+#define transport_init transport_poll_init
+#define transport_alloc transport_poll_alloc
+#define transport_send transport_poll_send
+#define transport_recv transport_poll_recv
+#define transport_release transport_poll_release
+#elif defined(CONFIG_APP_TRANSPORT_RING)
+typedef struct transport_ring transport_t;
+#define TRANSPORT_NAME "lock-free SPSC ring"
+#define transport_init transport_ring_init
+#define transport_alloc transport_ring_alloc
+#define transport_send transport_ring_send
+#define transport_recv transport_ring_recv
+#define transport_release transport_ring_release
+#elif defined(CONFIG_APP_TRANSPORT_FIFO)
+typedef struct transport_fifo transport_t;
+#define TRANSPORT_NAME "k_fifo + k_mem_slab"
+#define transport_init transport_fifo_init
+#define transport_alloc transport_fifo_alloc
+#define transport_send transport_fifo_send
+#define transport_recv transport_fifo_recv
+#define transport_release transport_fifo_release
+#endif
+
+#endif /* TRANSPORT_H */
@@ -0,0 +1,62 @@
+/*
+ * Média com rejeição das amostras afastadas da média mais do que uma banda (10% por omissão)
+ */
+
+#ifndef TRIMMED_MEAN_H
+#define TRIMMED_MEAN_H
+
+#include <zephyr.h>
+
+#define TRIMMED_MEAN_BUF_LEN(size) (size) /**< Elementos de memória de trabalho para uma janela de size amostras */
+#define TRIMMED_MEAN_BAND_PCT 10 /**< Banda inicial, em % da média */
+
+/** @brief Estado do filtro */
+struct trimmed_mean {
+	uint16_t *window;	/**< Janela circular de amostras, fornecida pelo chamador */
+	uint16_t size;		/**< Tamanho da janela */
+	uint16_t idx;		/**< Próxima posição a escrever */
+	uint32_t sum;		/**< Soma corrente da janela */
+	uint16_t band_pct;	/**< Meia largura da banda aceite, em % da média */
+};
+
+/** @brief Inicializa o filtro com a janela a zeros e a banda TRIMMED_MEAN_BAND_PCT
+ *
+ * @param f Filtro.
+ * @param buf Memória de trabalho com TRIMMED_MEAN_BUF_LEN(size) elementos.
+ * @param size Tamanho da janela (1..1024).
+ */
+void trimmed_mean_init(struct trimmed_mean *f, uint16_t *buf, uint16_t size);
+
+/** @brief Muda a banda sem reiniciar a janela
+ *
+ * @param f Filtro.
+ * @param band_pct Meia largura da banda, em % da média (0..100).
+ */
+static inline void trimmed_mean_set_band(struct trimmed_mean *f, uint16_t band_pct)
+{
+	f->band_pct = band_pct;
+}
+
+/** @brief Introduz uma amostra na janela, substituindo a mais antiga
+ *
+ * A soma da janela é atualizada em O(1).
+ */
+static inline void trimmed_mean_push(struct trimmed_mean *f, uint16_t sample)
+{
+	f->sum += sample - f->window[f->idx];
+	f->window[f->idx] = sample;
+	if (++f->idx == f->size) {
+		f->idx = 0;
+	}
+}
+
+/** @brief Média das amostras da janela dentro de ±band_pct % da média da janela
+ *
+ * Uma única passagem sobre a janela, só com aritmética inteira. Com a
+ * banda inicial o resultado é igual ao do algoritmo original da
+ * thread_FILTRO (desvio = media * 0.1, truncado); se nenhuma amostra
+ * estiver dentro da banda devolve 0.
+ */
+uint16_t trimmed_mean_output(const struct trimmed_mean *f);
+
+#endif /* TRIMMED_MEAN_H */
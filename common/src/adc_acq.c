@@ -0,0 +1,302 @@
+/*
+ * Aquisição de amostras da ADC, partilhada pelas aplicações Fifo e Semaphores
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <devicetree.h>
+#include <drivers/adc.h>
+#include <logging/log.h>
+
+#include "cycles.h"
+#include "adc_acq.h"
+#include "adc_board.h"
+
+LOG_MODULE_REGISTER(adc_acq, CONFIG_APP_LOG_LEVEL);
+
+/* Channel n samples the nRF ANn input. Note that a channel can be assigned to any ANx. In fact a channel can */
+/*    be assigned to two ANx, when differential reading is set (one ANx for the positive signal and the other one for the negative signal) */
+/* Note also that the configuration of differnt channels is completely independent (gain, resolution, ref voltage, ...) */
+#if DT_NODE_HAS_PROP(ADC_USER_NID, io_channels)
+#define ADC_CHANNEL_INPUT_ENTRY(node_id, prop, idx) DT_IO_CHANNELS_INPUT_BY_IDX(node_id, idx),
+const uint8_t adc_channel_inputs[ADC_NUM_CHANNELS] = {
+	DT_FOREACH_PROP_ELEM(ADC_USER_NID, io_channels, ADC_CHANNEL_INPUT_ENTRY)
+};
+#else
+const uint8_t adc_channel_inputs[ADC_NUM_CHANNELS] = { ADC_CHANNEL_ID };
+#endif
+
+/* ADC channel configuration, channel_id and input are filled in per channel */
+static const struct adc_channel_cfg my_channel_cfg = {
+	.gain = ADC_GAIN,
+	.reference = ADC_REFERENCE,
+	.acquisition_time = ADC_ACQUISITION_TIME,
+};
+
+static uint32_t adc_channel_mask; /**< Canais incluídos em cada varrimento */
+static uint8_t adc_oversampling = CONFIG_APP_ADC_OVERSAMPLING; /**< Sobreamostragem em hardware (2^N) */
+
+const struct device *adc_dev = NULL;
+
+#if defined(CONFIG_APP_ADC_ASYNC)
+/* One buffer is handed to the caller while the other one is being converted */
+static uint16_t adc_buffers[2][BUFFER_SIZE];
+static uint8_t adc_back; /**< Buffer da conversão em curso */
+static bool adc_in_flight; /**< Há uma conversão assíncrona em curso */
+
+static struct k_poll_signal adc_signal;
+static struct k_poll_event adc_event =
+	K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_SIGNAL,
+					K_POLL_MODE_NOTIFY_ONLY,
+					&adc_signal, 0);
+#else
+static uint16_t adc_buffers[1][BUFFER_SIZE];
+#endif
+
+uint16_t *adc_sample_buffer = adc_buffers[0];
+
+static uint16_t adc_burst_count; /**< Amostras escritas na rajada corrente */
+static uint16_t adc_ready_count; /**< Amostras válidas em adc_sample_buffer */
+static uint32_t adc_done_stamps[ARRAY_SIZE(adc_buffers)]; /**< Fim da última conversão de cada buffer (ciclos) */
+
+/** @brief Callback do driver da ADC, chamada no fim de cada amostragem da rajada */
+static enum adc_action adc_burst_callback(const struct device *dev,
+					  const struct adc_sequence *sequence,
+					  uint16_t sampling_index)
+{
+	/* Stamped per buffer: with async acquisition the next conversion may end before the caller reads it */
+	adc_done_stamps[((uint16_t *)sequence->buffer - adc_buffers[0]) / BUFFER_SIZE] = cycles_now();
+	adc_burst_count = sampling_index + 1;
+
+	return ADC_ACTION_CONTINUE;
+}
+
+#if defined(CONFIG_APP_ADC_CONTINUOUS)
+/* Samples are spaced by the driver timebase, the thread only wakes up once per burst */
+static const struct adc_sequence_options adc_burst_options = {
+	.interval_us = CONFIG_APP_ADC_INTERVAL_US,
+	.callback = adc_burst_callback,
+	.extra_samplings = ADC_BURST_SAMPLES - 1,
+};
+#else
+/* A single sampling, the callback only records when it ended */
+static const struct adc_sequence_options adc_burst_options = {
+	.callback = adc_burst_callback,
+};
+#endif
+
+int adc_acq_init(void)
+{
+	int err;
+
+	/* ADC setup: bind and initialize */
+	adc_dev = device_get_binding(DT_LABEL(ADC_NID));
+	if (!adc_dev) {
+		LOG_ERR("ADC device_get_binding() failed");
+		return -ENODEV;
+	}
+
+	adc_channel_mask = 0;
+	for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+		struct adc_channel_cfg cfg = my_channel_cfg;
+
+		/* The driver stores a scan in channel order, so the list order must match it */
+		if (i > 0 && adc_channel_inputs[i] <= adc_channel_inputs[i - 1]) {
+			LOG_ERR("ADC channels must be listed in ascending order");
+			return -EINVAL;
+		}
+
+		cfg.channel_id = adc_channel_inputs[i];
+		adc_board_channel_cfg(&cfg, adc_channel_inputs[i]);
+		err = adc_channel_setup(adc_dev, &cfg);
+		if (err) {
+			LOG_ERR("adc_channel_setup() failed with error code %d", err);
+			return err;
+		}
+		adc_channel_mask |= BIT(adc_channel_inputs[i]);
+	}
+
+	/* SAADC calibration, or the input waveforms of the ADC emulator */
+	err = adc_board_init(adc_dev);
+	if (err) {
+		LOG_ERR("adc_board_init() failed with error code %d", err);
+		return err;
+	}
+
+#if defined(CONFIG_APP_ADC_ASYNC)
+	k_poll_signal_init(&adc_signal);
+#endif
+
+	return 0;
+}
+
+#if defined(CONFIG_APP_ADC_ASYNC)
+/** @brief Arma uma conversão assíncrona para o buffer livre */
+static int adc_sample_start(void)
+{
+	/* Kept static: the sequence must outlive the call while the driver converts */
+	static struct adc_sequence sequence = {
+		.options = &adc_burst_options,
+		.buffer_size = sizeof(adc_buffers[0]),
+		.resolution = ADC_RESOLUTION,
+	};
+	int ret;
+
+	sequence.channels = adc_channel_mask;
+	sequence.oversampling = adc_oversampling;
+	sequence.buffer = adc_buffers[adc_back];
+	adc_burst_count = 0;
+	k_poll_signal_reset(&adc_signal);
+
+	ret = adc_read_async(adc_dev, &sequence, &adc_signal);
+	if (ret) {
+		LOG_ERR("adc_read_async() failed with code %d", ret);
+		return ret;
+	}
+
+	adc_in_flight = true;
+	return 0;
+}
+
+int adc_sample(void)
+{
+	unsigned int signaled;
+	int result;
+	int ret;
+
+	if (adc_dev == NULL) {
+		LOG_ERR("adc_sample(): error, must bind to adc first");
+		return -1;
+	}
+
+	/* First call: nothing converted yet, arm the pipeline */
+	if (!adc_in_flight) {
+		ret = adc_sample_start();
+		if (ret) {
+			return ret;
+		}
+	}
+
+	/* Normally already signaled, the conversion ran while the caller was busy */
+	ret = k_poll(&adc_event, 1, K_FOREVER);
+	adc_event.state = K_POLL_STATE_NOT_READY;
+	adc_in_flight = false;
+	if (ret) {
+		LOG_ERR("k_poll() failed with code %d", ret);
+		return ret;
+	}
+
+	k_poll_signal_check(&adc_signal, &signaled, &result);
+	adc_ready_count = adc_burst_count;
+	adc_sample_buffer = adc_buffers[adc_back];
+	adc_back ^= 1;
+
+	/* Queue the next conversion before handing this one over */
+	ret = adc_sample_start();
+	if (ret) {
+		return ret;
+	}
+
+	if (result) {
+		LOG_ERR("adc_read_async() completed with code %d", result);
+		adc_ready_count = 0;
+	}
+
+	return result;
+}
+#else
+int adc_sample(void)
+{
+	int ret;
+	const struct adc_sequence sequence = {
+		.options = &adc_burst_options,
+		.channels = adc_channel_mask,
+		.buffer = adc_sample_buffer,
+		.buffer_size = sizeof(adc_buffers[0]),
+		.resolution = ADC_RESOLUTION,
+		.oversampling = adc_oversampling,
+	};
+
+	if (adc_dev == NULL) {
+		LOG_ERR("adc_sample(): error, must bind to adc first");
+		return -1;
+	}
+
+	adc_burst_count = 0;
+	adc_ready_count = 0;
+
+	ret = adc_read(adc_dev, &sequence);
+	if (ret) {
+		LOG_ERR("adc_read() failed with code %d", ret);
+		return ret;
+	}
+
+	adc_ready_count = adc_burst_count;
+
+	return 0;
+}
+#endif /* CONFIG_APP_ADC_ASYNC */
+
+void adc_acq_set_oversampling(uint8_t oversampling)
+{
+	adc_oversampling = oversampling;
+}
+
+uint16_t adc_sample_count(void)
+{
+	return adc_ready_count;
+}
+
+uint32_t adc_sample_stamp(void)
+{
+	return adc_done_stamps[(adc_sample_buffer - adc_buffers[0]) / BUFFER_SIZE];
+}
+
+#if defined(CONFIG_APP_ADC_ISR)
+static adc_scan_callback_t adc_scan_cb; /**< Recebe cada varrimento, em contexto de interrupção */
+static struct k_poll_signal adc_isr_signal; /**< Só é levantado se a aquisição parar por erro */
+
+/** @brief Callback do driver da ADC no modo ADC_ISR: entrega o varrimento e repete a amostragem */
+static enum adc_action adc_isr_callback(const struct device *dev,
+					const struct adc_sequence *sequence,
+					uint16_t sampling_index)
+{
+	adc_scan_cb(sequence->buffer);
+
+	/* Same buffer again at the next interval, for ever */
+	return ADC_ACTION_REPEAT;
+}
+
+int adc_acq_start(uint32_t interval_us, adc_scan_callback_t cb)
+{
+	/* Kept static: the driver uses them for as long as the acquisition runs */
+	static struct adc_sequence_options options = {
+		.callback = adc_isr_callback,
+	};
+	static struct adc_sequence sequence = {
+		.options = &options,
+		.buffer = adc_buffers[0],
+		.buffer_size = sizeof(adc_buffers[0]),
+		.resolution = ADC_RESOLUTION,
+	};
+	int ret;
+
+	if (adc_dev == NULL) {
+		LOG_ERR("adc_acq_start(): error, must bind to adc first");
+		return -ENODEV;
+	}
+
+	adc_scan_cb = cb;
+	options.interval_us = interval_us;
+	sequence.channels = adc_channel_mask;
+	sequence.oversampling = adc_oversampling;
+	k_poll_signal_init(&adc_isr_signal);
+
+	ret = adc_read_async(adc_dev, &sequence, &adc_isr_signal);
+	if (ret) {
+		LOG_ERR("adc_read_async() failed with code %d", ret);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_APP_ADC_ISR */
@@ -0,0 +1,176 @@
+/*
+ * Emulador da ADC (native_posix, qemu_cortex_m3): formas de onda nas entradas
+ */
+
+#include <zephyr.h>
+#include <drivers/adc/adc_emul.h>
+#include <errno.h>
+
+#include "adc_acq.h"
+#include "adc_board.h"
+#include "adc_wave.h"
+
+/** @brief Forma de onda em uso num canal e o seu estado */
+struct wave_state {
+	struct adc_wave w;	/**< Descrição copiada de adc_wave_set() */
+	int64_t t0;		/**< Início da fase (us de uptime) */
+	uint32_t count;		/**< Conversões servidas */
+	uint32_t rng;		/**< Estado do gerador do ruído */
+};
+
+/*
+ * Two slots per channel: adc_wave_set() fills the one the emulator is not
+ * reading and switches with adc_emul_value_func_set(), which takes the
+ * same lock as a conversion, so the old slot is free once it returns.
+ */
+static struct wave_state waves[ADC_NUM_CHANNELS][2];
+static uint8_t wave_cur[ADC_NUM_CHANNELS]; /**< Slot em uso em cada canal */
+
+/* sin(i * pi / 32) * 32767: a quarter of a period */
+static const int16_t sine_quarter[17] = {
+	0, 3212, 6393, 9512, 12539, 15446, 18204, 20787, 23170,
+	25329, 27245, 28898, 30273, 31356, 32137, 32609, 32767,
+};
+
+/** @brief sin() de um quarto de período, a em 0..16384, interpolado */
+static int32_t quarter(uint32_t a)
+{
+	uint32_t i = a >> 10;
+	int32_t f = a & 1023;
+
+	if (i == 16) {
+		return sine_quarter[16];
+	}
+	return sine_quarter[i] + (((sine_quarter[i + 1] - sine_quarter[i]) * f) >> 10);
+}
+
+/** @brief 32767 * sin(2 * pi * phase / 65536) */
+static int32_t sine16(uint32_t phase)
+{
+	uint32_t x = phase & 0x3fff;
+
+	switch (phase >> 14) {
+	case 0:
+		return quarter(x);
+	case 1:
+		return quarter(16384 - x);
+	case 2:
+		return -quarter(x);
+	default:
+		return -quarter(16384 - x);
+	}
+}
+
+/** @brief Valor (mV) lido pelo emulador, chamado em cada conversão de um canal */
+static int wave_value(const struct device *dev, unsigned int chan, void *data, uint32_t *result)
+{
+	struct wave_state *s = data;
+	const struct adc_wave *w = &s->w;
+	uint64_t t = k_ticks_to_us_floor64(k_uptime_ticks()) - s->t0;
+	int32_t amp = w->amplitude_mv;
+	int32_t v = w->offset_mv;
+	uint32_t phase = 0; /* 0..65535 over a period */
+
+	if (w->period_us) {
+		phase = (uint32_t)((t % w->period_us) * 65536 / w->period_us);
+	}
+
+	switch (w->shape) {
+	case ADC_WAVE_SINE:
+		v += amp * sine16(phase) / 32767;
+		break;
+	case ADC_WAVE_SQUARE:
+		v += phase < 32768 ? amp : -amp;
+		break;
+	case ADC_WAVE_TRIANGLE:
+		/* -amp at the start of the period, +amp in the middle */
+		v += amp * (phase < 32768 ? (int32_t)phase * 2 - 32768 : 98304 - (int32_t)phase * 2) / 32768;
+		break;
+	case ADC_WAVE_TABLE:
+		v = w->table[(w->step_us ? (uint32_t)(t / w->step_us) : s->count) % w->table_len];
+		break;
+	default:
+		break;
+	}
+	s->count++;
+
+	if (w->noise_mv) {
+		/* xorshift32: cheap, and the same sequence on every run */
+		s->rng ^= s->rng << 13;
+		s->rng ^= s->rng >> 17;
+		s->rng ^= s->rng << 5;
+		v += (int32_t)(s->rng % (2U * w->noise_mv + 1)) - w->noise_mv;
+	}
+
+	*result = CLAMP(v, 0, CONFIG_APP_ADC_FULL_SCALE_MV);
+
+	return 0;
+}
+
+int adc_wave_set(int c, const struct adc_wave *w)
+{
+	struct wave_state *s;
+	int err;
+
+	if (c < 0 || c >= ADC_NUM_CHANNELS) {
+		return -EINVAL;
+	}
+	if (w->shape == ADC_WAVE_TABLE ? (w->table == NULL || w->table_len == 0) :
+	    (w->shape != ADC_WAVE_CONST && w->period_us == 0)) {
+		return -EINVAL;
+	}
+	if (adc_dev == NULL) {
+		return -ENODEV;
+	}
+
+	s = &waves[c][wave_cur[c] ^ 1];
+	s->w = *w;
+	s->t0 = k_ticks_to_us_floor64(k_uptime_ticks());
+	s->count = 0;
+	s->rng = 0x9e3779b9U + c;
+
+	err = adc_emul_value_func_set(adc_dev, adc_channel_inputs[c], wave_value, s);
+	if (err == 0) {
+		wave_cur[c] ^= 1;
+	}
+
+	return err;
+}
+
+uint32_t adc_wave_samples(int c)
+{
+	return waves[c][wave_cur[c]].count;
+}
+
+void adc_board_channel_cfg(struct adc_channel_cfg *cfg, uint8_t input)
+{
+}
+
+int adc_board_init(const struct device *dev)
+{
+	const struct adc_wave w = {
+#if defined(CONFIG_APP_ADC_EMUL_WAVE_SINE)
+		.shape = ADC_WAVE_SINE,
+#elif defined(CONFIG_APP_ADC_EMUL_WAVE_SQUARE)
+		.shape = ADC_WAVE_SQUARE,
+#elif defined(CONFIG_APP_ADC_EMUL_WAVE_TRIANGLE)
+		.shape = ADC_WAVE_TRIANGLE,
+#else
+		.shape = ADC_WAVE_CONST,
+#endif
+		.offset_mv = CONFIG_APP_ADC_EMUL_INPUT_MV,
+		.amplitude_mv = CONFIG_APP_ADC_EMUL_AMPLITUDE_MV,
+		.period_us = CONFIG_APP_ADC_EMUL_PERIOD_MS * USEC_PER_MSEC,
+		.noise_mv = CONFIG_APP_ADC_EMUL_NOISE_MV,
+	};
+	int err;
+
+	for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+		err = adc_wave_set(c, &w);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,16 @@
+/*
+ * ADC sem particularidades: a configuração comum de adc_acq.c basta
+ */
+
+#include <zephyr.h>
+
+#include "adc_board.h"
+
+void adc_board_channel_cfg(struct adc_channel_cfg *cfg, uint8_t input)
+{
+}
+
+int adc_board_init(const struct device *dev)
+{
+	return 0;
+}
@@ -0,0 +1,23 @@
+/*
+ * Particularidades da SAADC do nRF52840
+ */
+
+#include <zephyr.h>
+/*ADC include*/
+#include <hal/nrf_saadc.h>
+
+#include "adc_board.h"
+
+void adc_board_channel_cfg(struct adc_channel_cfg *cfg, uint8_t input)
+{
+	/* Channel n samples the nRF ANn input */
+	cfg->input_positive = NRF_SAADC_INPUT_AIN0 + input;
+}
+
+int adc_board_init(const struct device *dev)
+{
+	/* It is recommended to calibrate the SAADC at least once before use, and whenever the ambient temperature has changed by more than 10 °C */
+	NRF_SAADC->TASKS_CALIBRATEOFFSET = 1;
+
+	return 0;
+}
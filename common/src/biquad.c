@@ -0,0 +1,53 @@
+/*
+ * Filtro IIR biquad (forma direta I)
+ */
+
+#include <zephyr.h>
+
+#include "biquad.h"
+
+/* Bilinear transform, K = tan(pi / 20), Q = 1/sqrt(2); DC gain is exactly 1 in Q14 */
+const struct biquad_coeffs biquad_lowpass_fs20 = {
+	.b0 = 329, .b1 = 658, .b2 = 329,
+	.a1 = -25576, .a2 = 10508,
+};
+
+void biquad_init(struct biquad *f, uint16_t *buf, uint16_t size)
+{
+	ARG_UNUSED(buf);
+	ARG_UNUSED(size);
+
+	f->c = &biquad_lowpass_fs20;
+	f->x1 = f->x2 = 0;
+	f->y1 = f->y2 = 0;
+}
+
+void biquad_set_coeffs(struct biquad *f, const struct biquad_coeffs *c)
+{
+	f->c = c;
+}
+
+void biquad_push(struct biquad *f, uint16_t sample)
+{
+	const struct biquad_coeffs *c = f->c;
+	int64_t acc;
+
+	/* The feedback path keeps 8 fractional bits, otherwise slow inputs get stuck in a dead band */
+	acc = ((int64_t)c->b0 * sample + (int64_t)c->b1 * f->x1 + (int64_t)c->b2 * f->x2) * 256 -
+	      (int64_t)c->a1 * f->y1 - (int64_t)c->a2 * f->y2;
+
+	f->x2 = f->x1;
+	f->x1 = sample;
+	f->y2 = f->y1;
+	f->y1 = (int32_t)((acc + BIT(BIQUAD_Q - 1)) >> BIQUAD_Q);
+}
+
+uint16_t biquad_output(const struct biquad *f)
+{
+	int32_t y = (f->y1 + BIT(7)) >> 8;
+
+	if (y < 0) {
+		return 0;
+	}
+	return y > UINT16_MAX ? UINT16_MAX : y;
+}
@@ -0,0 +1,143 @@
+/*
+ * Filtros FIR e IIR biquad em Q15, processados por blocos
+ */
+
+#include <zephyr.h>
+#include <string.h>
+
+#include "dsp_filter.h"
+
+/* The Q14 Butterworth from biquad.c, with the feedback terms negated as CMSIS expects */
+const q15_t dsp_biquad_lowpass_fs20[DSP_BIQUAD_COEFFS_LEN(1)] = {
+	329, 0, 658, 329, 25576, -10508,
+};
+
+/** @brief Satura um acumulador para Q15, como __SSAT(x, 16) */
+static inline q15_t dsp_sat_q15(int64_t x)
+{
+	if (x > INT16_MAX) {
+		return INT16_MAX;
+	}
+	return x < INT16_MIN ? INT16_MIN : x;
+}
+
+int dsp_fir_init(struct dsp_fir *f, const q15_t *coeffs, uint16_t taps, q15_t *state,
+		 uint16_t max_block)
+{
+	if (taps < 4 || (taps & 1)) {
+		return -EINVAL;
+	}
+
+	f->coeffs = coeffs;
+	f->state = state;
+	f->taps = taps;
+	memset(state, 0, DSP_FIR_STATE_LEN(taps, max_block) * sizeof(state[0]));
+
+#if defined(CONFIG_CMSIS_DSP)
+	if (arm_fir_init_q15(&f->arm, taps, coeffs, state, max_block) != ARM_MATH_SUCCESS) {
+		return -EINVAL;
+	}
+#endif
+
+	return 0;
+}
+
+void dsp_fir_process_c(struct dsp_fir *f, const q15_t *in, q15_t *out, uint16_t n)
+{
+	/* Same layout as CMSIS: taps - 1 history samples followed by the new block */
+	q15_t *hist = f->state;
+
+	memcpy(&hist[f->taps - 1], in, n * sizeof(in[0]));
+
+	for (int i = 0; i < n; i++) {
+		int64_t acc = 0;
+
+		for (int k = 0; k < f->taps; k++) {
+			acc += (int32_t)f->coeffs[k] * hist[i + k];
+		}
+		out[i] = dsp_sat_q15(acc >> 15);
+	}
+
+	memmove(hist, &hist[n], (f->taps - 1) * sizeof(hist[0]));
+}
+
+void dsp_fir_process(struct dsp_fir *f, const q15_t *in, q15_t *out, uint16_t n)
+{
+#if defined(CONFIG_CMSIS_DSP)
+	arm_fir_q15(&f->arm, in, out, n);
+#else
+	dsp_fir_process_c(f, in, out, n);
+#endif
+}
+
+void dsp_fir_triangular(q15_t *coeffs, uint16_t taps)
+{
+	/* Odd length keeps the response symmetric, the spare tap of an even length stays at 0 */
+	uint16_t len = (taps & 1) ? taps : taps - 1;
+	/* Coefficients are reversed: put the spare tap on the oldest sample, not the newest */
+	q15_t *h = &coeffs[taps - len];
+	uint32_t sum = 0;
+	uint32_t acc = 0;
+
+	for (int k = 0; k < len; k++) {
+		sum += MIN(k + 1, len - k);
+	}
+
+	memset(coeffs, 0, taps * sizeof(coeffs[0]));
+	for (int k = 0; k < len; k++) {
+		/* Cumulative rounding keeps the DC gain at exactly 1 */
+		uint32_t next = acc + MIN(k + 1, len - k);
+
+		h[k] = (((uint64_t)next << 15) + sum / 2) / sum -
+		       (((uint64_t)acc << 15) + sum / 2) / sum;
+		acc = next;
+	}
+}
+
+void dsp_biquad_init(struct dsp_biquad *f, const q15_t *coeffs, uint8_t stages, q15_t *state,
+		     int8_t post_shift)
+{
+	f->coeffs = coeffs;
+	f->state = state;
+	f->stages = stages;
+	f->post_shift = post_shift;
+	memset(state, 0, DSP_BIQUAD_STATE_LEN(stages) * sizeof(state[0]));
+
+#if defined(CONFIG_CMSIS_DSP)
+	arm_biquad_cascade_df1_init_q15(&f->arm, stages, coeffs, state, post_shift);
+#endif
+}
+
+void dsp_biquad_process_c(struct dsp_biquad *f, const q15_t *in, q15_t *out, uint16_t n)
+{
+	const q15_t *src = in;
+
+	for (int s = 0; s < f->stages; s++) {
+		const q15_t *c = &f->coeffs[6 * s];
+		q15_t *st = &f->state[4 * s];
+
+		/* Each stage filters the whole block, the next one works on its output */
+		for (int i = 0; i < n; i++) {
+			q15_t x = src[i];
+			int64_t acc = (int32_t)c[0] * x + (int32_t)c[2] * st[0] + (int32_t)c[3] * st[1] +
+				      (int32_t)c[4] * st[2] + (int32_t)c[5] * st[3];
+			q15_t y = dsp_sat_q15(acc >> (15 - f->post_shift));
+
+			st[1] = st[0];
+			st[0] = x;
+			st[3] = st[2];
+			st[2] = y;
+			out[i] = y;
+		}
+		src = out;
+	}
+}
+
+void dsp_biquad_process(struct dsp_biquad *f, const q15_t *in, q15_t *out, uint16_t n)
+{
+#if defined(CONFIG_CMSIS_DSP)
+	arm_biquad_cascade_df1_q15(&f->arm, in, out, n);
+#else
+	dsp_biquad_process_c(f, in, out, n);
+#endif
+}
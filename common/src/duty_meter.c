@@ -0,0 +1,58 @@
+/*
+ * Medição do duty-cycle efetivo de uma thread periódica
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+
+#include "cycles.h"
+#include "duty_meter.h"
+
+LOG_MODULE_REGISTER(duty_meter, CONFIG_APP_LOG_LEVEL);
+
+void duty_meter_init(struct duty_meter *m, const char *name)
+{
+	cycles_init();
+
+	m->name = name;
+	m->last = cycles_now();
+	m->busy = 0;
+	m->idle = 0;
+	m->activations = 0;
+}
+
+void duty_meter_busy(struct duty_meter *m)
+{
+	uint32_t now = cycles_now();
+
+	/* Deltas are accumulated on every transition so the 32 bit counter never wraps inside one */
+	m->idle += now - m->last;
+	m->last = now;
+}
+
+void duty_meter_idle(struct duty_meter *m)
+{
+	uint32_t now = cycles_now();
+	uint64_t total;
+	uint32_t duty;
+
+	m->busy += now - m->last;
+	m->last = now;
+
+	if (CONFIG_APP_DUTY_REPORT == 0 || ++m->activations < CONFIG_APP_DUTY_REPORT) {
+		return;
+	}
+
+	total = m->busy + m->idle;
+	if (total != 0) {
+		/* Hundredths of a percent */
+		duty = (uint32_t)((m->busy * 10000U) / total);
+		LOG_INF("%s thread duty cycle: %u.%02u %% (busy %u us in %u activations)",
+			m->name, duty / 100, duty % 100,
+			(uint32_t)(cycles_to_ns(m->busy) / 1000U), m->activations);
+	}
+
+	m->busy = 0;
+	m->idle = 0;
+	m->activations = 0;
+}
@@ -0,0 +1,27 @@
+/*
+ * Média móvel exponencial
+ */
+
+#include <zephyr.h>
+
+#include "ema.h"
+
+void ema_init(struct ema *f, uint16_t *buf, uint16_t size)
+{
+	ARG_UNUSED(buf);
+
+	f->y = 0;
+	f->alpha = (2 * 32768 + (size + 1) / 2) / (size + 1);
+}
+
+void ema_push(struct ema *f, uint16_t sample)
+{
+	int32_t diff = ((int32_t)sample << 8) - f->y;
+
+	f->y += (int32_t)(((int64_t)diff * f->alpha) >> 15);
+}
+
+uint16_t ema_output(const struct ema *f)
+{
+	return (f->y + BIT(7)) >> 8;
+}
@@ -0,0 +1,59 @@
+/*
+ * Etapa de filtragem por blocos da thread_FILTRO (CONFIG_APP_FILTER_BLOCK)
+ */
+
+#include <zephyr.h>
+
+#include "filter_block.h"
+
+#if defined(CONFIG_APP_FILTER_BLOCK_FIR)
+static q15_t fir_coeffs[FILTER_BLOCK_TAPS]; /* Shared by all channels */
+#endif
+
+int filter_block_init(struct filter_block *f)
+{
+	f->last = 0;
+
+#if defined(CONFIG_APP_FILTER_BLOCK_FIR)
+	dsp_fir_triangular(fir_coeffs, FILTER_BLOCK_TAPS);
+	return dsp_fir_init(&f->fir, fir_coeffs, FILTER_BLOCK_TAPS, f->state, FILTER_BLOCK_SIZE);
+#else
+	dsp_biquad_init(&f->biquad, dsp_biquad_lowpass_fs20, 1, f->state, 1);
+	return 0;
+#endif
+}
+
+uint16_t filter_block_run(struct filter_block *f, const uint16_t *in, uint16_t *out, size_t stride,
+			  size_t n)
+{
+	/* Up to 1 KiB together, too much for a thread stack; only the FILTRO stage runs blocks */
+	static q15_t x[FILTER_BLOCK_SIZE];
+	static q15_t y[FILTER_BLOCK_SIZE];
+
+	while (n > 0) {
+		uint16_t len = MIN(n, FILTER_BLOCK_SIZE);
+
+		/* Gather one channel out of the interleaved scans */
+		for (int i = 0; i < len; i++) {
+			x[i] = MIN(*in, INT16_MAX >> FILTER_BLOCK_SHIFT) << FILTER_BLOCK_SHIFT;
+			in += stride;
+		}
+
+#if defined(CONFIG_APP_FILTER_BLOCK_FIR)
+		dsp_fir_process(&f->fir, x, y, len);
+#else
+		dsp_biquad_process(&f->biquad, x, y, len);
+#endif
+
+		/* Back to mV; the whole chunk was gathered first, so out may alias in */
+		for (int i = 0; out != NULL && i < len; i++) {
+			*out = MAX(y[i] + BIT(FILTER_BLOCK_SHIFT - 1), 0) >> FILTER_BLOCK_SHIFT;
+			out += stride;
+		}
+
+		f->last = MAX(y[len - 1] + BIT(FILTER_BLOCK_SHIFT - 1), 0) >> FILTER_BLOCK_SHIFT;
+		n -= len;
+	}
+
+	return f->last;
+}
@@ -0,0 +1,63 @@
+/*
+ * Filtro FIR
+ */
+
+#include <zephyr.h>
+#include <string.h>
+
+#include "fir.h"
+
+void fir_init(struct fir *f, uint16_t *buf, uint16_t size)
+{
+	f->window = buf;
+	f->coeffs = NULL;
+	f->size = size;
+	f->idx = 0;
+	memset(buf, 0, size * sizeof(buf[0]));
+
+	f->tri_sum = 0;
+	for (int k = 0; k < size; k++) {
+		f->tri_sum += MIN(k + 1, size - k);
+	}
+}
+
+void fir_set_coeffs(struct fir *f, const int16_t *coeffs)
+{
+	f->coeffs = coeffs;
+}
+
+void fir_push(struct fir *f, uint16_t sample)
+{
+	f->window[f->idx] = sample;
+	if (++f->idx == f->size) {
+		f->idx = 0;
+	}
+}
+
+uint16_t fir_output(const struct fir *f)
+{
+	int64_t acc = 0;
+	int j = f->idx;
+
+	if (f->coeffs == NULL) {
+		uint64_t tri = 0;
+
+		for (int k = 0; k < f->size; k++) {
+			j = (j == 0) ? f->size - 1 : j - 1;
+			tri += (uint32_t)MIN(k + 1, f->size - k) * f->window[j];
+		}
+		return tri / f->tri_sum;
+	}
+
+	/* k counts samples back from the most recent one */
+	for (int k = 0; k < f->size; k++) {
+		j = (j == 0) ? f->size - 1 : j - 1;
+		acc += (int32_t)f->coeffs[k] * f->window[j];
+	}
+
+	acc = (acc + BIT(14)) >> 15;
+	if (acc < 0) {
+		return 0;
+	}
+	return acc > UINT16_MAX ? UINT16_MAX : acc;
+}
@@ -0,0 +1,145 @@
+/*
+ * Traço de latência do pipeline, da conversão da ADC à escrita no PWM
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+
+#include "cycles.h"
+#include "latency_trace.h"
+
+LOG_MODULE_REGISTER(latency_trace, CONFIG_APP_LOG_LEVEL);
+
+#define RING_SIZE CONFIG_APP_TRACE_RING_SIZE
+
+BUILD_ASSERT((RING_SIZE & (RING_SIZE - 1)) == 0, "APP_TRACE_RING_SIZE must be a power of 2");
+
+static struct trace_entry ring[RING_SIZE];
+static uint32_t head; /* Entries ever recorded, the next one goes to ring[head % RING_SIZE] */
+static uint32_t unstamped;
+
+static struct latency_hist hist[TRACE_SPANS] = {
+	[0 ... TRACE_SPANS - 1] = { .min = UINT32_MAX },
+};
+
+static const char *const span_names[TRACE_SPANS] = {
+	[TRACE_ADC_TO_FILTER] = "adc -> filter",
+	[TRACE_FILTER] = "filter",
+	[TRACE_FILTER_TO_PWM] = "filter -> pwm",
+	[TRACE_END_TO_END] = "adc -> pwm",
+};
+
+/** @brief Classe de v: os 4 primeiros valores diretos, depois MSB e os dois bits seguintes */
+static int bucket_of(uint32_t v)
+{
+	int msb;
+
+	if (v < 4) {
+		return v;
+	}
+	msb = find_msb_set(v) - 1;
+	return ((msb - 1) << 2) | ((v >> (msb - 2)) & 3);
+}
+
+/** @brief Maior valor da classe b */
+static uint32_t bucket_max(int b)
+{
+	int msb;
+	uint64_t low;
+
+	if (b < 4) {
+		return b;
+	}
+	msb = (b >> 2) + 1;
+	low = (uint64_t)(4 | (b & 3)) << (msb - 2);
+	return (uint32_t)MIN(low + BIT64(msb - 2) - 1, UINT32_MAX);
+}
+
+static void hist_add(struct latency_hist *h, uint32_t v)
+{
+	h->min = MIN(h->min, v);
+	h->max = MAX(h->max, v);
+	h->sum += v;
+	h->count++;
+	h->bucket[bucket_of(v)]++;
+}
+
+void latency_trace_record(const struct trace_entry *e)
+{
+	ring[head++ & (RING_SIZE - 1)] = *e;
+	if (e->t_adc == 0) {
+		unstamped++;
+	}
+
+	/* Unsigned differences: a counter wrap between two stamps is harmless */
+	hist_add(&hist[TRACE_ADC_TO_FILTER], e->t_filter_in - e->t_adc);
+	hist_add(&hist[TRACE_FILTER], e->t_filter_out - e->t_filter_in);
+	hist_add(&hist[TRACE_FILTER_TO_PWM], e->t_pwm - e->t_filter_out);
+	hist_add(&hist[TRACE_END_TO_END], e->t_pwm - e->t_adc);
+}
+
+uint32_t latency_trace_percentile(enum trace_span span, uint32_t pct)
+{
+	const struct latency_hist *h = &hist[span];
+	uint64_t rank;
+	uint64_t seen = 0;
+
+	if (h->count == 0) {
+		return 0;
+	}
+
+	/* Smallest bucket holding at least pct % of the blocks */
+	rank = MAX(DIV_ROUND_UP((uint64_t)h->count * MIN(pct, 100), 100), 1);
+	for (int b = 0; b < LATENCY_HIST_BUCKETS; b++) {
+		seen += h->bucket[b];
+		if (seen >= rank) {
+			return (uint32_t)cycles_to_ns(MIN(bucket_max(b), h->max));
+		}
+	}
+	return (uint32_t)cycles_to_ns(h->max);
+}
+
+void latency_trace_reset(void)
+{
+	for (int s = 0; s < TRACE_SPANS; s++) {
+		hist[s] = (struct latency_hist){ .min = UINT32_MAX };
+	}
+	unstamped = 0;
+}
+
+uint32_t latency_trace_unstamped(void)
+{
+	return unstamped;
+}
+
+const char *latency_trace_span_name(enum trace_span span)
+{
+	return span_names[span];
+}
+
+int latency_trace_last(struct trace_entry *out, int n)
+{
+	uint32_t end = head;
+	uint32_t count = MIN(MIN(end, (uint32_t)RING_SIZE), (uint32_t)n);
+
+	for (uint32_t i = 0; i < count; i++) {
+		out[i] = ring[(end - count + i) & (RING_SIZE - 1)];
+	}
+	return count;
+}
+
+void latency_trace_report(void)
+{
+	for (int s = 0; s < TRACE_SPANS; s++) {
+		const struct latency_hist *h = &hist[s];
+
+		if (h->count == 0) {
+			continue;
+		}
+		LOG_INF("%-13s min %u avg %u p50 %u p90 %u p99 %u max %u ns (%u blocks)",
+			span_names[s], (uint32_t)cycles_to_ns(h->min),
+			(uint32_t)cycles_to_ns(h->sum / h->count), latency_trace_percentile(s, 50),
+			latency_trace_percentile(s, 90), latency_trace_percentile(s, 99),
+			(uint32_t)cycles_to_ns(h->max), h->count);
+	}
+}
@@ -0,0 +1,66 @@
+/*
+ * Mediana numa janela deslizante
+ */
+
+#include <zephyr.h>
+#include <string.h>
+
+#include "median.h"
+
+void median_init(struct median *f, uint16_t *buf, uint16_t size)
+{
+	f->window = buf;
+	f->sorted = buf + size;
+	f->size = size;
+	f->idx = 0;
+	memset(buf, 0, MEDIAN_BUF_LEN(size) * sizeof(buf[0]));
+}
+
+/** @brief Primeira posição de sorted com valor >= value */
+static int median_lower_bound(const struct median *f, uint16_t value)
+{
+	int lo = 0;
+	int hi = f->size;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		if (f->sorted[mid] < value) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+void median_push(struct median *f, uint16_t sample)
+{
+	int old = median_lower_bound(f, f->window[f->idx]);
+	int pos = median_lower_bound(f, sample);
+
+	/* Slide the entries between the two positions over the removed one */
+	if (pos > old) {
+		pos--;
+		memmove(&f->sorted[old], &f->sorted[old + 1], (pos - old) * sizeof(f->sorted[0]));
+	} else {
+		memmove(&f->sorted[pos + 1], &f->sorted[pos], (old - pos) * sizeof(f->sorted[0]));
+	}
+	f->sorted[pos] = sample;
+
+	f->window[f->idx] = sample;
+	if (++f->idx == f->size) {
+		f->idx = 0;
+	}
+}
+
+uint16_t median_output(const struct median *f)
+{
+	uint16_t mid = f->size / 2;
+
+	if (f->size & 1) {
+		return f->sorted[mid];
+	}
+	return (f->sorted[mid - 1] + f->sorted[mid]) / 2;
+}
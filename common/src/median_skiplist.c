@@ -0,0 +1,170 @@
+/*
+ * Mediana numa janela deslizante sobre uma skiplist indexável
+ *
+ * Cada ligação guarda quantas posições salta, o que permite encontrar o
+ * elemento de ordem k descendo pelos níveis, tal como numa procura por
+ * valor.
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/__assert.h>
+
+#include "median_skiplist.h"
+
+#define NIL UINT16_MAX	/* End of a level */
+#define HEAD 0		/* Head node, holds no sample */
+
+/** @brief Número de níveis de um novo nó: cada nível extra com probabilidade 1/4 */
+static uint16_t median_skiplist_levels(struct median_skiplist *f)
+{
+	uint32_t r;
+	uint16_t levels = 1;
+
+	/* xorshift32 */
+	f->seed ^= f->seed << 13;
+	f->seed ^= f->seed >> 17;
+	f->seed ^= f->seed << 5;
+
+	for (r = f->seed; levels < MEDIAN_SKIPLIST_LEVELS && (r & 3) == 0; r >>= 2) {
+		levels++;
+	}
+
+	return levels;
+}
+
+/** @brief Liga o nó n, com valor já atribuído, na posição ordenada */
+static void median_skiplist_insert(struct median_skiplist *f, uint16_t n)
+{
+	struct median_skiplist_node *nodes = f->nodes;
+	uint16_t chain[MEDIAN_SKIPLIST_LEVELS];
+	uint16_t steps_at_level[MEDIAN_SKIPLIST_LEVELS];
+	uint16_t value = nodes[n].value;
+	uint16_t node = HEAD;
+	uint16_t steps = 0;
+
+	for (int level = MEDIAN_SKIPLIST_LEVELS - 1; level >= 0; level--) {
+		steps_at_level[level] = 0;
+		while (nodes[node].next[level] != NIL && nodes[nodes[node].next[level]].value <= value) {
+			steps_at_level[level] += nodes[node].width[level];
+			node = nodes[node].next[level];
+		}
+		chain[level] = node;
+	}
+
+	nodes[n].levels = median_skiplist_levels(f);
+	for (int level = 0; level < nodes[n].levels; level++) {
+		struct median_skiplist_node *prev = &nodes[chain[level]];
+
+		/* steps: distance from chain[level] to the new node's predecessor */
+		nodes[n].next[level] = prev->next[level];
+		prev->next[level] = n;
+		nodes[n].width[level] = prev->width[level] - steps;
+		prev->width[level] = steps + 1;
+		steps += steps_at_level[level];
+	}
+	for (int level = nodes[n].levels; level < MEDIAN_SKIPLIST_LEVELS; level++) {
+		nodes[chain[level]].width[level]++;
+	}
+}
+
+/** @brief Desliga um nó com o valor dado e devolve o seu índice */
+static uint16_t median_skiplist_remove(struct median_skiplist *f, uint16_t value)
+{
+	struct median_skiplist_node *nodes = f->nodes;
+	uint16_t chain[MEDIAN_SKIPLIST_LEVELS];
+	uint16_t node = HEAD;
+	uint16_t n;
+
+	for (int level = MEDIAN_SKIPLIST_LEVELS - 1; level >= 0; level--) {
+		while (nodes[node].next[level] != NIL && nodes[nodes[node].next[level]].value < value) {
+			node = nodes[node].next[level];
+		}
+		chain[level] = node;
+	}
+
+	/* The value is in the window, so the first node not below it holds it */
+	n = nodes[chain[0]].next[0];
+	__ASSERT_NO_MSG(n != NIL && nodes[n].value == value);
+
+	for (int level = 0; level < nodes[n].levels; level++) {
+		struct median_skiplist_node *prev = &nodes[chain[level]];
+
+		prev->width[level] += nodes[n].width[level] - 1;
+		prev->next[level] = nodes[n].next[level];
+	}
+	for (int level = nodes[n].levels; level < MEDIAN_SKIPLIST_LEVELS; level++) {
+		nodes[chain[level]].width[level]--;
+	}
+
+	return n;
+}
+
+void median_skiplist_init(struct median_skiplist *f, uint16_t *buf, uint16_t size)
+{
+	struct median_skiplist_node *head;
+
+	f->window = buf;
+	f->nodes = (struct median_skiplist_node *)(buf + size);
+	f->size = size;
+	f->idx = 0;
+	f->seed = 0x2545f491;
+	memset(buf, 0, MEDIAN_SKIPLIST_BUF_LEN(size) * sizeof(buf[0]));
+
+	head = &f->nodes[HEAD];
+	head->levels = MEDIAN_SKIPLIST_LEVELS;
+	for (int level = 0; level < MEDIAN_SKIPLIST_LEVELS; level++) {
+		head->next[level] = NIL;
+		head->width[level] = 1;
+	}
+
+	/* The window starts full of zeros, node i + 1 stands for window[i] */
+	for (uint16_t i = 1; i <= size; i++) {
+		median_skiplist_insert(f, i);
+	}
+}
+
+void median_skiplist_push(struct median_skiplist *f, uint16_t sample)
+{
+	uint16_t n = median_skiplist_remove(f, f->window[f->idx]);
+
+	f->nodes[n].value = sample;
+	median_skiplist_insert(f, n);
+
+	f->window[f->idx] = sample;
+	if (++f->idx == f->size) {
+		f->idx = 0;
+	}
+}
+
+/** @brief Nó na posição rank (0 = menor valor) */
+static uint16_t median_skiplist_at(const struct median_skiplist *f, uint16_t rank)
+{
+	const struct median_skiplist_node *nodes = f->nodes;
+	uint16_t node = HEAD;
+	uint16_t i = rank + 1;
+
+	for (int level = MEDIAN_SKIPLIST_LEVELS - 1; level >= 0; level--) {
+		while (nodes[node].next[level] != NIL && nodes[node].width[level] <= i) {
+			i -= nodes[node].width[level];
+			node = nodes[node].next[level];
+		}
+	}
+
+	return node;
+}
+
+uint16_t median_skiplist_output(const struct median_skiplist *f)
+{
+	const struct median_skiplist_node *nodes = f->nodes;
+	uint16_t mid = f->size / 2;
+	uint16_t node;
+
+	if (f->size & 1) {
+		return nodes[median_skiplist_at(f, mid)].value;
+	}
+
+	/* The upper middle element is the next one on the bottom level */
+	node = median_skiplist_at(f, mid - 1);
+	return (nodes[node].value + nodes[nodes[node].next[0]].value) / 2;
+}
@@ -0,0 +1,31 @@
+/*
+ * Média móvel simples
+ */
+
+#include <zephyr.h>
+#include <string.h>
+
+#include "moving_avg.h"
+
+void moving_avg_init(struct moving_avg *f, uint16_t *buf, uint16_t size)
+{
+	f->window = buf;
+	f->size = size;
+	f->idx = 0;
+	f->sum = 0;
+	memset(buf, 0, size * sizeof(buf[0]));
+}
+
+void moving_avg_push(struct moving_avg *f, uint16_t sample)
+{
+	f->sum += sample - f->window[f->idx];
+	f->window[f->idx] = sample;
+	if (++f->idx == f->size) {
+		f->idx = 0;
+	}
+}
+
+uint16_t moving_avg_output(const struct moving_avg *f)
+{
+	return f->sum / f->size;
+}
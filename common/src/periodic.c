@@ -0,0 +1,70 @@
+/*
+ * Ativação periódica sem deriva, baseada num k_timer
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+
+#include "periodic.h"
+
+LOG_MODULE_REGISTER(periodic, CONFIG_APP_LOG_LEVEL);
+
+void periodic_start(struct periodic *p, struct k_timer *timer, uint32_t period_ms)
+{
+	p->timer = timer;
+	p->activations = 0;
+	p->missed = 0;
+	p->max_lateness_us = 0;
+	p->sum_lateness_us = 0;
+
+	k_timer_init(timer, NULL, NULL);
+	periodic_set_period(p, period_ms);
+}
+
+void periodic_set_period(struct periodic *p, uint32_t period_ms)
+{
+	p->period = k_ms_to_ticks_ceil64(period_ms);
+	p->index = 0;
+
+	/* The kernel re-arms a periodic k_timer from its previous deadline, so the phase never slips */
+	p->origin = k_uptime_ticks();
+	k_timer_start(p->timer, K_TICKS(p->period), K_TICKS(p->period));
+}
+
+uint32_t periodic_wait(struct periodic *p)
+{
+	uint32_t expired;
+	uint32_t lateness_us;
+	int64_t release;
+	int64_t now;
+
+	/* Returns at once if the timer already expired, with the number of expiries since the last call */
+	expired = k_timer_status_sync(p->timer);
+	now = k_uptime_ticks();
+
+	if (expired == 0) {
+		/* Timer stopped */
+		return 0;
+	}
+
+	p->index += expired;
+	p->activations++;
+	p->missed += expired - 1;
+
+	release = p->origin + (int64_t)p->index * p->period;
+	lateness_us = (now > release) ? (uint32_t)k_ticks_to_us_floor64(now - release) : 0;
+	p->sum_lateness_us += lateness_us;
+	if (lateness_us > p->max_lateness_us) {
+		p->max_lateness_us = lateness_us;
+	}
+
+	return expired - 1;
+}
+
+void periodic_report(const struct periodic *p, const char *name)
+{
+	uint32_t avg_us = p->activations ? (uint32_t)(p->sum_lateness_us / p->activations) : 0;
+
+	LOG_INF("%s activations: %u, missed: %u, lateness avg/max: %u/%u us",
+		name, p->activations, p->missed, avg_us, p->max_lateness_us);
+}
@@ -0,0 +1,708 @@
+/*
+ * Pipeline ADC -> filtro -> PWM, partilhado pelas aplicações Fifo e Semaphores
+ *
+ * A thread_ADC é periódica; a thread_FILTRO e a thread_PWM são esporádicas
+ * e são ativadas pelo transporte escolhido em APP_TRANSPORT. Com
+ * APP_PIPELINE_WORKQ as três etapas são k_work encadeados numa só
+ * k_work_q e correm até ao fim uma a seguir à outra.
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+#include <string.h>
+
+#include "adc_acq.h"
+#include "adc_conv.h"
+#include "cycles.h"
+#include "duty_meter.h"
+#include "periodic.h"
+#include "filter.h"
+#include "latency_trace.h"
+#include "transport.h"
+#include "pipeline.h"
+#include "pipeline_cfg.h"
+#include "pwm_out.h"
+#if defined(CONFIG_APP_REPLAY)
+#include "replay.h"
+#endif
+#include "sched_rta.h"
+#include "thread_stats.h"
+
+LOG_MODULE_REGISTER(pipeline, CONFIG_APP_LOG_LEVEL);
+
+#define SIZE CONFIG_APP_FILTER_WINDOW /**< Janela do filtro digital (amostras) */
+
+/* Size of stack area used by each thread (can be thread specific, if necessary) */
+#define STACK_SIZE CONFIG_APP_THREAD_STACK_SIZE /**< Tamanho da stack usada por cada thread */
+
+/* Thread scheduling priority (APP_SCHED_EQUAL and APP_SCHED_EDF; APP_SCHED_DM starts from the same value) */
+#define thread_ADC_prio 1 /**< Prioridade de escalonamento da thread que recebe as amostras da ADC */
+#define thread_FILTRO_prio 1 /**< Prioridade de escalonamento da thread que atua como filtro digital */
+#define thread_PWM_prio 1 /**< Prioridade de escalonamento da thread que manipula o duty-cycle do PWM */
+
+#define pipeline_workq_prio 1 /**< Prioridade da work queue do pipeline (APP_PIPELINE_WORKQ) */
+
+/* Thread periodicity (in ms); initial value, it can be changed at runtime (pipeline_cfg) */
+#define thread_ADC_period 1000 /**< Período de amostragem da ADC em milisegundos */
+
+#define PWM_PERIOD_US 1000 /**< Período inicial do PWM em microsegundos */
+
+/* A block per ADC burst: the period of every stage */
+#if defined(CONFIG_APP_ADC_CONTINUOUS)
+#define BLOCK_PERIOD_US (CONFIG_APP_ADC_INTERVAL_US * ADC_BURST_SAMPLES) /**< Período das rajadas (us) */
+#else
+#define BLOCK_PERIOD_US (thread_ADC_period * USEC_PER_MSEC) /**< Período das rajadas (us) */
+#endif
+
+#if defined(CONFIG_APP_PIPELINE_WORKQ)
+/* One stack for the three stages, which run to completion one after the other */
+K_THREAD_STACK_DEFINE(pipeline_workq_stack, STACK_SIZE); /**< Stack da work queue do pipeline */
+struct k_work_q pipeline_workq; /**< Work queue onde correm as três etapas */
+struct k_timer my_timer; /**< Timer que submete a etapa ADC a cada período */
+
+static struct k_work adc_work; /**< Etapa ADC */
+static struct k_work filtro_work; /**< Etapa FILTRO, submetida pela etapa ADC */
+static struct k_work pwm_work; /**< Etapa PWM, submetida pela etapa FILTRO */
+
+/* Single queue, FIFO order: a stage always finishes with a block before the previous one rewrites it */
+static struct sample_block adc_blk; /**< Rajada passada da etapa ADC à etapa FILTRO */
+static struct sample_block pwm_blk; /**< Rajada filtrada passada da etapa FILTRO à etapa PWM */
+
+static uint32_t workq_activations; /**< Ativações do timer */
+static uint32_t workq_missed; /**< Ativações perdidas por a etapa ADC ainda estar na fila */
+#else
+#if !defined(CONFIG_APP_ADC_ISR)
+struct k_timer my_timer; /**< Timer que marca as ativações periódicas da thread_ADC */
+struct periodic adc_periodic;
+
+/* Create thread stack space; in ADC_ISR mode the ADC driver callback replaces thread_ADC */
+K_THREAD_STACK_DEFINE(thread_ADC_stack, STACK_SIZE); /**< Stack da thread_ADC */
+struct k_thread thread_ADC_data; /**< Dados da thread_ADC */
+k_tid_t thread_ADC_tid; /**< Task ID da thread_ADC */
+#endif
+
+K_THREAD_STACK_DEFINE(thread_FILTRO_stack, STACK_SIZE); /**< Stack da thread_FILTRO */
+K_THREAD_STACK_DEFINE(thread_PWM_stack, STACK_SIZE); /**< Stack da thread_PWM */
+
+/* Create variables for thread data */
+struct k_thread thread_FILTRO_data; /**< Dados da thread_FILTRO */
+struct k_thread thread_PWM_data; /**< Dados da thread_PWM */
+
+/* Create task IDs */
+k_tid_t thread_FILTRO_tid; /**< Task ID da thread_FILTRO */
+k_tid_t thread_PWM_tid; /**< Task ID da thread_PWM */
+
+transport_t adc_link;
+transport_t pwm_link;
+
+enum { STAGE_ADC, STAGE_FILTRO, STAGE_PWM, STAGE_COUNT };
+
+/** @brief Etapas como tarefas periódicas: prioridade, deadline e WCET medido (APP_SCHED) */
+static struct rta_task stages[STAGE_COUNT] = {
+	[STAGE_ADC] = { .name = "ADC", .deadline_us = CONFIG_APP_SCHED_DEADLINE_ADC_US },
+	[STAGE_FILTRO] = { .name = "FILTRO", .deadline_us = CONFIG_APP_SCHED_DEADLINE_FILTRO_US },
+	[STAGE_PWM] = { .name = "PWM", .deadline_us = CONFIG_APP_SCHED_DEADLINE_PWM_US },
+};
+#endif /* CONFIG_APP_PIPELINE_WORKQ */
+
+/* Filter state, one window per channel */
+#if defined(CONFIG_APP_FILTER_BLOCK)
+static struct filter_block filtro[ADC_NUM_CHANNELS];
+#else
+static uint16_t filtro_mem[ADC_NUM_CHANNELS][FILTER_BUF_LEN(SIZE)];
+static filter_t filtro[ADC_NUM_CHANNELS];
+#endif
+static uint32_t filtered_blocks; /**< Blocos filtrados, para os relatórios */
+static uint32_t acquired_samples; /**< Varrimentos adquiridos pela etapa ADC */
+
+/* Each stage keeps its own copy, refreshed without locks (pipeline_cfg_refresh()) */
+static struct pipeline_cfg filtro_cfg; /**< Configuração vista pela etapa FILTRO */
+static struct pipeline_cfg pwm_cfg; /**< Configuração vista pela etapa PWM */
+
+/** @brief Mensagem inicial e inicialização da ADC */
+static int adc_setup(void)
+{
+	int err;
+
+	/* Welcome message */
+	LOG_INF("Simple adc demo");
+	for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+		LOG_INF("Reads an analog input connected to AN%d and prints its raw and mV value",
+			adc_channel_inputs[c]);
+	}
+	LOG_INF("*** ASSURE THAT ANx IS BETWEEN [0...3V]");
+
+	/* ADC setup: bind, initialize and calibrate */
+	err = adc_acq_init();
+	if (err) {
+		LOG_ERR("adc_acq_init() failed with error code %d", err);
+	}
+
+	return err;
+}
+
+#if !defined(CONFIG_APP_PIPELINE_WORKQ)
+/** @brief Início de uma ativação de uma thread do pipeline (só para a análise de tempo de resposta) */
+static void stage_begin(struct rta_task *t)
+{
+	rta_job_begin(t);
+}
+
+/** @brief Com APP_SCHED_EDF fixa a deadline da próxima ativação de uma etapa
+ *
+ * O escalonador ordena as threads prontas pela deadline que têm quando
+ * ficam prontas, por isso quem acorda a etapa fixa-a antes do envio; a
+ * própria thread, já a correr, fá-lo-ia tarde demais. Se a etapa ainda
+ * estiver ocupada, a deadline passa a ser a dos dados que vai ler a seguir.
+ *
+ * @param tid Thread da etapa.
+ * @param t Etapa, com a deadline relativa.
+ * @param release_cyc Ciclos de agora até à ativação (0 se é agora).
+ */
+static void stage_deadline(k_tid_t tid, const struct rta_task *t, uint32_t release_cyc)
+{
+#if defined(CONFIG_APP_SCHED_EDF)
+	/* Relative to now: the absolute deadline of that activation */
+	k_thread_deadline_set(tid, release_cyc + k_us_to_cyc_ceil32(t->deadline_us));
+#endif
+}
+
+/** @brief Prioridades e períodos das etapas conforme APP_SCHED */
+static void sched_setup(void)
+{
+	stages[STAGE_ADC].prio = thread_ADC_prio;
+	stages[STAGE_FILTRO].prio = thread_FILTRO_prio;
+	stages[STAGE_PWM].prio = thread_PWM_prio;
+	stages[STAGE_FILTRO].period_us = BLOCK_PERIOD_US;
+	stages[STAGE_PWM].period_us = BLOCK_PERIOD_US;
+#if defined(CONFIG_APP_ADC_ISR)
+	/* The ADC callback runs once per scan and preempts every thread */
+	stages[STAGE_ADC].prio = RTA_PRIO_ISR;
+	stages[STAGE_ADC].period_us = BLOCK_PERIOD_US / ADC_BURST_SAMPLES;
+#else
+	stages[STAGE_ADC].period_us = BLOCK_PERIOD_US;
+#endif
+
+#if defined(CONFIG_APP_SCHED_DM)
+	/* Shortest deadline first, from the priority the three threads shared */
+	rta_assign_dm(stages, STAGE_COUNT, thread_FILTRO_prio);
+#endif
+	LOG_INF("Scheduling: %s", IS_ENABLED(CONFIG_APP_SCHED_DM) ? "deadline-monotonic" :
+		IS_ENABLED(CONFIG_APP_SCHED_EDF) ? "EDF" : "equal priorities");
+}
+#endif /* CONFIG_APP_PIPELINE_WORKQ */
+
+#if defined(CONFIG_APP_ADC_ISR)
+static struct sample_block *isr_blk; /**< Rajada a ser preenchida pelo callback da ADC */
+
+/** @brief Callback da ADC, em contexto de interrupção
+ *
+ * Converte o varrimento para mV e acrescenta-o à rajada corrente, que
+ * é enviada à thread_FILTRO ao fim de ADC_BURST_SAMPLES varrimentos.
+ */
+static void adc_scan_isr(const uint16_t *raw)
+{
+	rta_job_begin(&stages[STAGE_ADC]);
+
+	if (isr_blk == NULL) {
+		/* No free block: the burst is dropped and counted by the transport */
+		isr_blk = transport_alloc(&adc_link);
+		if (isr_blk == NULL) {
+			rta_job_end(&stages[STAGE_ADC]);
+			return;
+		}
+		isr_blk->count = 0;
+	}
+
+	/* Nothing is logged per scan, out of range readings are just zeroed */
+	for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+		isr_blk->data[isr_blk->count][c] = raw[c] > ADC_RAW_MAX ? 0 : adc_raw_to_mv(raw[c]);
+	}
+
+	acquired_samples++;
+	if (++isr_blk->count == ADC_BURST_SAMPLES) {
+		isr_blk->t_adc = cycles_now();
+		stage_deadline(thread_FILTRO_tid, &stages[STAGE_FILTRO], 0);
+		transport_send(&adc_link, isr_blk);
+		isr_blk = NULL;
+	}
+
+	rta_job_end(&stages[STAGE_ADC]);
+}
+#else
+/** @brief Converte para mV os varrimentos da última rajada da ADC
+ *
+ * @param mv Destino, um varrimento (um valor por canal) por linha.
+ * @param count Número de varrimentos.
+ */
+static void converte_rajada(uint16_t (*mv)[ADC_NUM_CHANNELS], int count)
+{
+	for (int s = 0; s < count; s++) {
+		for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+			uint16_t raw = adc_sample_buffer[s * ADC_NUM_CHANNELS + c];
+
+			if (raw > ADC_RAW_MAX) {
+				LOG_WRN("adc reading out of range");
+				mv[s][c] = 0;
+				continue;
+			}
+
+			/* ADC is set to use gain of 1/4 and reference VDD/4, so input range is 0...VDD (3 V) */
+			mv[s][c] = adc_raw_to_mv(raw);
+			if (!IS_ENABLED(CONFIG_APP_ADC_CONTINUOUS)) {
+				LOG_DBG("adc reading AN%u: raw:%4u / mV: %4u",
+					adc_channel_inputs[c], raw, mv[s][c]);
+			}
+		}
+	}
+}
+
+#if !defined(CONFIG_APP_PIPELINE_WORKQ)
+void thread_ADC_code(void *argA, void *argB, void *argC)
+{
+	struct sample_block *blk;
+	struct duty_meter duty; /* Effective duty cycle of this thread */
+	struct pipeline_cfg cfg = { 0 };
+	int err;
+
+	adc_setup();
+#if defined(CONFIG_APP_REPLAY)
+	/* With --replay-in the ADC reads the recording instead of the configured waveform */
+	replay_start();
+#endif
+
+	/* Drift-free periodic activation on my_timer (unused in continuous mode, the ADC paces the bursts) */
+	pipeline_cfg_refresh(&cfg);
+	if (!IS_ENABLED(CONFIG_APP_ADC_CONTINUOUS)) {
+		periodic_start(&adc_periodic, &my_timer, cfg.period_ms);
+		stage_deadline(k_current_get(), &stages[STAGE_ADC], 0);
+	}
+	duty_meter_init(&duty, "ADC");
+
+	while (1) {
+#if defined(CONFIG_APP_ADC_CONTINUOUS)
+		/* The burst acquisition paces the thread, waiting for it is idle time */
+		duty_meter_idle(&duty);
+		err = adc_sample();
+		duty_meter_busy(&duty);
+		/* Released by the end of the burst, nothing else can set the deadline earlier */
+		stage_deadline(k_current_get(), &stages[STAGE_ADC], 0);
+		stage_begin(&stages[STAGE_ADC]);
+#else
+		stage_begin(&stages[STAGE_ADC]);
+		err = adc_sample();
+#endif
+
+		if (err) {
+			LOG_ERR("adc_sample() failed with error code %d", err);
+		} else {
+			acquired_samples += adc_sample_count();
+			blk = transport_alloc(&adc_link);
+			if (blk != NULL) {
+				/* One block carries the whole burst: a value per channel per scan */
+				blk->t_adc = adc_sample_stamp();
+				blk->count = adc_sample_count();
+				converte_rajada(blk->data, blk->count);
+				/* A full link drops or coalesces per APP_TRANSPORT_OVERLOAD, counted in adc_link.stats */
+				stage_deadline(thread_FILTRO_tid, &stages[STAGE_FILTRO], 0);
+				transport_send(&adc_link, blk);
+			}
+		}
+
+#if defined(CONFIG_APP_ADC_CONTINUOUS)
+		/* The ADC driver paces the burst, no need to sleep */
+		LOG_DBG("adc burst: %u scans of %u channel(s), last raw:%4u",
+			adc_sample_count(), ADC_NUM_CHANNELS, adc_sample_buffer[BUFFER_SIZE - 1]);
+		rta_job_end(&stages[STAGE_ADC]);
+#else
+		rta_job_end(&stages[STAGE_ADC]);
+
+#if defined(CONFIG_APP_REPLAY)
+		/* Full speed: the next scan as soon as this one reached the PWM, no release instants */
+		if (replay_active()) {
+			replay_next();
+			stage_deadline(k_current_get(), &stages[STAGE_ADC], 0);
+			continue;
+		}
+#endif
+
+		/* Deadline of the next activation, set now: the timer that releases it has no callback */
+		int64_t release = periodic_next_release(&adc_periodic) - k_uptime_ticks();
+
+		stage_deadline(k_current_get(), &stages[STAGE_ADC],
+			       release > 0 ? k_ticks_to_cyc_floor32(release) : 0);
+
+		/* Wait for next release instant */
+		duty_meter_idle(&duty);
+		uint32_t missed = periodic_wait(&adc_periodic);
+		duty_meter_busy(&duty);
+		if (missed) {
+			LOG_WRN("thread_ADC overrun: %u activation(s) missed, %u in total",
+				missed, adc_periodic.missed);
+		}
+		if (CONFIG_APP_DUTY_REPORT && adc_periodic.activations % CONFIG_APP_DUTY_REPORT == 0) {
+			periodic_report(&adc_periodic, "thread_ADC");
+		}
+
+		/* A new period restarts the phase from now (the counters are kept) */
+		uint32_t period_ms = cfg.period_ms;
+
+		if (pipeline_cfg_refresh(&cfg) && cfg.period_ms != period_ms) {
+			periodic_set_period(&adc_periodic, cfg.period_ms);
+			for (int i = 0; i < STAGE_COUNT; i++) {
+				stages[i].period_us = cfg.period_ms * USEC_PER_MSEC;
+			}
+			LOG_INF("thread_ADC period: %u ms", cfg.period_ms);
+		}
+#endif
+	}
+}
+#endif /* CONFIG_APP_PIPELINE_WORKQ */
+#endif /* CONFIG_APP_ADC_ISR */
+
+/** @brief Inicializa o filtro de cada canal com a janela e a banda de filtro_cfg */
+static void filtro_init(void)
+{
+	pipeline_cfg_refresh(&filtro_cfg);
+
+	for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+#if defined(CONFIG_APP_FILTER_BLOCK)
+		if (filter_block_init(&filtro[c])) {
+			LOG_ERR("filter_block_init() failed");
+		}
+#else
+		/* filtro_mem holds the largest window, APP_FILTER_WINDOW */
+		filter_init(&filtro[c], filtro_mem[c], filtro_cfg.window);
+#if defined(CONFIG_APP_FILTER_TRIMMED_MEAN)
+		trimmed_mean_set_band(&filtro[c], filtro_cfg.band_pct);
+#endif
+#endif
+	}
+	LOG_INF("Filter: %s, window %d", FILTER_NAME, filtro_cfg.window);
+}
+
+/** @brief Aplica à etapa FILTRO uma configuração publicada entretanto
+ *
+ * Uma janela nova reinicia o filtro (janela a zeros); uma banda nova só
+ * muda o critério de rejeição.
+ */
+static void filtro_refresh(void)
+{
+	uint16_t window = filtro_cfg.window;
+
+	/* The usual case: one atomic read, no lock */
+	if (!pipeline_cfg_refresh(&filtro_cfg)) {
+		return;
+	}
+
+	if (filtro_cfg.window != window) {
+		filtro_init();
+		return;
+	}
+#if defined(CONFIG_APP_FILTER_TRIMMED_MEAN)
+	for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+		trimmed_mean_set_band(&filtro[c], filtro_cfg.band_pct);
+	}
+#endif
+}
+
+/** @brief Relatório periódico: latências e, com threads, contadores das ligações */
+static void pipeline_report(void)
+{
+	struct pipeline_cfg cfg = { 0 };
+	uint32_t worst_ns = latency_trace_percentile(TRACE_END_TO_END, 100);
+
+	latency_trace_report();
+
+	/* A block older than one period means the links are backing up (or lost its t_adc) */
+	pipeline_cfg_refresh(&cfg);
+	if (cfg.period_ms != 0 && worst_ns > (uint64_t)cfg.period_ms * USEC_PER_MSEC * NSEC_PER_USEC) {
+		LOG_WRN("adc -> pwm max %u ns exceeds the %u ms period", worst_ns, cfg.period_ms);
+	}
+#if defined(CONFIG_APP_THREAD_STATS)
+	thread_stats_report();
+#endif
+#if defined(CONFIG_APP_PIPELINE_WORKQ)
+	LOG_INF("pipeline workq activations: %u, missed: %u", workq_activations, workq_missed);
+#else
+	transport_report(&adc_link.stats, "adc link");
+	transport_report(&pwm_link.stats, "pwm link");
+#if defined(CONFIG_APP_SCHED_EDF)
+	rta_report_edf(stages, STAGE_COUNT);
+#else
+	rta_report(stages, STAGE_COUNT);
+#endif
+#endif
+}
+
+/** @brief Etapa FILTRO: filtra os varrimentos de in para out
+ *
+ * O estado do filtro acompanha todas as amostras, mesmo que out venha a
+ * ser descartado.
+ */
+static void filtra_bloco(const struct sample_block *in, struct sample_block *out)
+{
+	out->t_filter_in = cycles_now();
+	out->t_adc = in->t_adc;
+	out->count = in->count;
+
+	filtro_refresh();
+
+	if (IS_ENABLED(CONFIG_APP_FILTER_BYPASS)) {
+		/* Noise is already reduced upstream (e.g. hardware oversampling) */
+		memcpy(out->data, in->data, in->count * sizeof(in->data[0]));
+	} else {
+		for (int c = 0; c < ADC_NUM_CHANNELS && in->count > 0; c++) {
+			/* Kernel chosen at build time (APP_FILTER) */
+#if defined(CONFIG_APP_FILTER_BLOCK)
+			filter_block_run(&filtro[c], &in->data[0][c], &out->data[0][c],
+					 ADC_NUM_CHANNELS, in->count);
+#else
+			for (int s = 0; s < in->count; s++) {
+				filter_push(&filtro[c], in->data[s][c]);
+				out->data[s][c] = filter_output(&filtro[c]);
+			}
+#endif
+		}
+	}
+
+	for (int c = 0; c < ADC_NUM_CHANNELS && out->count > 0; c++) {
+		LOG_DBG("Media Final AN%u: %4u", adc_channel_inputs[c],
+			out->data[out->count - 1][c]);
+	}
+
+	out->t_filter_out = cycles_now();
+
+	filtered_blocks++;
+}
+
+/** @brief Etapa PWM: cada canal comanda o seu pino com o valor filtrado mais recente do bloco */
+static void aplica_duty(const struct sample_block *blk)
+{
+	unsigned int pwmPeriod_us; /* PWM period in us */
+	unsigned int val_duty = 0;
+
+	pipeline_cfg_refresh(&pwm_cfg);
+	pwmPeriod_us = pwm_cfg.pwm_period_us;
+
+	for (int c = 0; c < ADC_NUM_CHANNELS && blk->count > 0; c++) {
+		val_duty = (blk->data[blk->count - 1][c] * 100) / 3000;
+
+		/* Board PWM, or the stub that records it (APP_PWM_STUB) */
+		pwm_out_set(c, pwmPeriod_us, val_duty);
+	}
+
+	/* Same stamps in every execution mode: thread, work queue or ADC callback */
+	latency_trace_record(&(struct trace_entry){
+		.t_adc = blk->t_adc,
+		.t_filter_in = blk->t_filter_in,
+		.t_filter_out = blk->t_filter_out,
+		.t_pwm = cycles_now(),
+	});
+}
+
+#if defined(CONFIG_APP_PIPELINE_WORKQ)
+/** @brief Timer da etapa ADC: submete-a, ou conta uma ativação perdida se ainda estiver na fila */
+static void adc_timer_expiry(struct k_timer *timer)
+{
+	workq_activations++;
+	if (k_work_submit_to_queue(&pipeline_workq, &adc_work) == 0) {
+		workq_missed++;
+	}
+}
+
+/** @brief Etapa ADC: adquire uma rajada e submete a etapa FILTRO */
+static void adc_work_handler(struct k_work *work)
+{
+	static struct pipeline_cfg cfg;
+	uint32_t period_ms = cfg.period_ms;
+	int err;
+
+	/* A new period restarts the timer from now; the first refresh only takes the initial one */
+	if (pipeline_cfg_refresh(&cfg) && !IS_ENABLED(CONFIG_APP_ADC_CONTINUOUS) && period_ms != 0 &&
+	    cfg.period_ms != period_ms) {
+		k_timer_start(&my_timer, K_MSEC(cfg.period_ms), K_MSEC(cfg.period_ms));
+		LOG_INF("pipeline workq period: %u ms", cfg.period_ms);
+	}
+
+	err = adc_sample();
+	if (err) {
+		LOG_ERR("adc_sample() failed with error code %d", err);
+	} else {
+		acquired_samples += adc_sample_count();
+		adc_blk.t_adc = adc_sample_stamp();
+		adc_blk.count = adc_sample_count();
+		converte_rajada(adc_blk.data, adc_blk.count);
+		k_work_submit_to_queue(&pipeline_workq, &filtro_work);
+	}
+
+#if defined(CONFIG_APP_ADC_CONTINUOUS)
+	/* The ADC driver paces the bursts: queue the next one behind this burst's stages */
+	k_work_submit_to_queue(&pipeline_workq, &adc_work);
+#endif
+}
+
+/** @brief Etapa FILTRO: filtra a rajada e submete a etapa PWM */
+static void filtro_work_handler(struct k_work *work)
+{
+	filtra_bloco(&adc_blk, &pwm_blk);
+	k_work_submit_to_queue(&pipeline_workq, &pwm_work);
+
+	if (CONFIG_APP_DUTY_REPORT && filtered_blocks % CONFIG_APP_DUTY_REPORT == 0) {
+		pipeline_report();
+	}
+}
+
+/** @brief Etapa PWM */
+static void pwm_work_handler(struct k_work *work)
+{
+	aplica_duty(&pwm_blk);
+}
+#else
+void thread_FILTRO_code(void *argA, void *argB, void *argC)
+{
+	static struct sample_block scratch; /* Filter output when thread_PWM has no free block */
+	struct sample_block *in;
+	struct sample_block *out;
+
+	filtro_init();
+
+	while (1) {
+		in = transport_recv(&adc_link, K_FOREVER);
+		stage_begin(&stages[STAGE_FILTRO]);
+
+		/* The filter state must follow every sample, even if the result is dropped */
+		out = transport_alloc(&pwm_link);
+		if (out == NULL) {
+			out = &scratch;
+		}
+
+		filtra_bloco(in, out);
+		transport_release(&adc_link, in);
+
+		if (out != &scratch) {
+			stage_deadline(thread_PWM_tid, &stages[STAGE_PWM], 0);
+			transport_send(&pwm_link, out);
+		}
+		rta_job_end(&stages[STAGE_FILTRO]);
+
+		/* Outside the measured job, the report is not part of the stage */
+		if (CONFIG_APP_DUTY_REPORT && filtered_blocks % CONFIG_APP_DUTY_REPORT == 0) {
+			pipeline_report();
+		}
+	}
+}
+
+void thread_PWM_code(void *argA, void *argB, void *argC)
+{
+	struct sample_block *blk;
+
+	pwm_out_init();
+
+	while (1) {
+		blk = transport_recv(&pwm_link, K_FOREVER);
+		stage_begin(&stages[STAGE_PWM]);
+		aplica_duty(blk);
+		transport_release(&pwm_link, blk);
+		rta_job_end(&stages[STAGE_PWM]);
+	}
+}
+#endif /* CONFIG_APP_PIPELINE_WORKQ */
+
+void pipeline_counters_get(struct pipeline_counters *c)
+{
+	c->samples = acquired_samples;
+	c->blocks = filtered_blocks;
+#if defined(CONFIG_APP_PIPELINE_WORKQ)
+	/* One block per stage and one queue: a burst is never dropped, a late activation is */
+	c->drops = 0;
+	c->overruns = workq_missed;
+#else
+	c->drops = adc_link.stats.dropped + adc_link.stats.coalesced +
+		   pwm_link.stats.dropped + pwm_link.stats.coalesced;
+#if defined(CONFIG_APP_ADC_ISR) || defined(CONFIG_APP_ADC_CONTINUOUS)
+	/* The ADC driver paces the bursts: no activation to miss */
+	c->overruns = 0;
+#else
+	c->overruns = adc_periodic.missed;
+#endif
+#endif
+}
+
+void pipeline_start(void)
+{
+	/* Every stage stamps its blocks, whatever the execution mode */
+	cycles_init();
+
+	/* Compile-time values, changed afterwards only through pipeline_cfg_set() */
+	pipeline_cfg_init(&(struct pipeline_cfg){
+		.period_ms = thread_ADC_period,
+		.window = SIZE,
+#if defined(CONFIG_APP_FILTER_TRIMMED_MEAN)
+		.band_pct = TRIMMED_MEAN_BAND_PCT,
+#endif
+		.pwm_period_us = PWM_PERIOD_US,
+	});
+
+#if defined(CONFIG_APP_PIPELINE_WORKQ)
+	const struct k_work_queue_config cfg = { .name = "pipeline_workq" };
+
+	LOG_INF("Execution: run-to-completion work queue");
+	k_work_queue_init(&pipeline_workq);
+	k_work_queue_start(&pipeline_workq, pipeline_workq_stack,
+			   K_THREAD_STACK_SIZEOF(pipeline_workq_stack), pipeline_workq_prio, &cfg);
+	k_work_init(&adc_work, adc_work_handler);
+	k_work_init(&filtro_work, filtro_work_handler);
+	k_work_init(&pwm_work, pwm_work_handler);
+
+	/* Runs once, before any stage: setup in the caller's context */
+	adc_setup();
+	filtro_init();
+	pwm_out_init();
+
+#if defined(CONFIG_APP_ADC_CONTINUOUS)
+	k_work_submit_to_queue(&pipeline_workq, &adc_work);
+#else
+	/* The timer re-arms from its previous deadline, so the sampling phase does not drift */
+	k_timer_init(&my_timer, adc_timer_expiry, NULL);
+	k_timer_start(&my_timer, K_MSEC(thread_ADC_period), K_MSEC(thread_ADC_period));
+#endif
+#else
+	if (transport_init(&adc_link) || transport_init(&pwm_link)) {
+		LOG_ERR("transport_init() failed");
+		return;
+	}
+	LOG_INF("Transport: %s", TRANSPORT_NAME);
+	sched_setup();
+
+	/* Create tasks; the consumers first, the ADC callback sets thread_FILTRO's deadline */
+	thread_FILTRO_tid = k_thread_create(&thread_FILTRO_data, thread_FILTRO_stack,
+					    K_THREAD_STACK_SIZEOF(thread_FILTRO_stack), thread_FILTRO_code,
+					    NULL, NULL, NULL, stages[STAGE_FILTRO].prio, 0, K_NO_WAIT);
+	k_thread_name_set(thread_FILTRO_tid, "thread_FILTRO");
+
+	thread_PWM_tid = k_thread_create(&thread_PWM_data, thread_PWM_stack,
+					 K_THREAD_STACK_SIZEOF(thread_PWM_stack), thread_PWM_code,
+					 NULL, NULL, NULL, stages[STAGE_PWM].prio, 0, K_NO_WAIT);
+	k_thread_name_set(thread_PWM_tid, "thread_PWM");
+
+#if defined(CONFIG_APP_ADC_ISR)
+	/* The ADC driver callback converts and sends each burst: no thread_ADC */
+	if (adc_setup() == 0) {
+#if defined(CONFIG_APP_ADC_CONTINUOUS)
+		int err = adc_acq_start(CONFIG_APP_ADC_INTERVAL_US, adc_scan_isr);
+#else
+		int err = adc_acq_start(thread_ADC_period * USEC_PER_MSEC, adc_scan_isr);
+#endif
+		if (err) {
+			LOG_ERR("adc_acq_start() failed with error code %d", err);
+		}
+	}
+#else
+	thread_ADC_tid = k_thread_create(&thread_ADC_data, thread_ADC_stack,
+					 K_THREAD_STACK_SIZEOF(thread_ADC_stack), thread_ADC_code,
+					 NULL, NULL, NULL, stages[STAGE_ADC].prio, 0, K_NO_WAIT);
+	k_thread_name_set(thread_ADC_tid, "thread_ADC");
+#endif
+#endif /* CONFIG_APP_PIPELINE_WORKQ */
+}
@@ -0,0 +1,85 @@
+/*
+ * Parâmetros do pipeline alteráveis em tempo de execução
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+
+#include "pipeline_cfg.h"
+
+static struct pipeline_cfg cfg_buf[2]; /* Generation g is in cfg_buf[g & 1] */
+static atomic_t cfg_seq; /* 2 * published generation, +1 while a writer fills the other buffer */
+static K_MUTEX_DEFINE(cfg_lock); /* Writers only */
+
+/** @brief Publica c como geração seguinte; chamada com cfg_lock */
+static void publish(const struct pipeline_cfg *c)
+{
+	/* Odd: generation g + 1 is being written into the buffer readers are not meant to read */
+	uint32_t seq = atomic_inc(&cfg_seq);
+	struct pipeline_cfg *next = &cfg_buf[(seq / 2 + 1) & 1];
+
+	*next = *c;
+	next->gen = seq / 2 + 1;
+	/* Even again: the new generation is published */
+	atomic_inc(&cfg_seq);
+}
+
+void pipeline_cfg_init(const struct pipeline_cfg *c)
+{
+	k_mutex_lock(&cfg_lock, K_FOREVER);
+	publish(c);
+	k_mutex_unlock(&cfg_lock);
+}
+
+bool pipeline_cfg_refresh(struct pipeline_cfg *c)
+{
+	uint32_t gen = (uint32_t)atomic_get(&cfg_seq) / 2;
+
+	/* The usual case in the hot path: a single atomic read */
+	if (gen == c->gen) {
+		return false;
+	}
+
+	for (;;) {
+		gen = (uint32_t)atomic_get(&cfg_seq) / 2;
+		*c = cfg_buf[gen & 1];
+		/* cfg_buf[gen & 1] is only reused once generation gen + 2 starts, at seq 2 * gen + 3 */
+		if ((uint32_t)atomic_get(&cfg_seq) - 2 * gen < 3) {
+			break;
+		}
+	}
+	c->gen = gen;
+
+	return true;
+}
+
+int pipeline_cfg_set(const struct pipeline_cfg *c)
+{
+	const struct pipeline_cfg *cur;
+	int err = 0;
+
+	/* The period in us (sched_rta) must fit in 32 bits */
+	if (c->period_ms == 0 || c->period_ms > UINT32_MAX / USEC_PER_MSEC || c->window == 0 || c->window > CONFIG_APP_FILTER_WINDOW ||
+	    c->band_pct > 100 || c->pwm_period_us == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&cfg_lock, K_FOREVER);
+	cur = &cfg_buf[((uint32_t)atomic_get(&cfg_seq) / 2) & 1];
+
+	/* Paced by the ADC driver, or no sample filter, or no band: the value is not used */
+	if ((IS_ENABLED(CONFIG_APP_ADC_CONTINUOUS) || IS_ENABLED(CONFIG_APP_ADC_ISR)) &&
+	    c->period_ms != cur->period_ms) {
+		err = -ENOTSUP;
+	} else if (IS_ENABLED(CONFIG_APP_FILTER_BLOCK) && c->window != cur->window) {
+		err = -ENOTSUP;
+	} else if (!IS_ENABLED(CONFIG_APP_FILTER_TRIMMED_MEAN) && c->band_pct != cur->band_pct) {
+		err = -ENOTSUP;
+	} else {
+		publish(c);
+	}
+
+	k_mutex_unlock(&cfg_lock);
+
+	return err;
+}
@@ -0,0 +1,114 @@
+/*
+ * Comandos de shell do pipeline: contadores e parâmetros em tempo de execução
+ */
+
+#include <zephyr.h>
+#include <shell/shell.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "latency_trace.h"
+#include "pipeline.h"
+#include "pipeline_cfg.h"
+#if defined(CONFIG_APP_THREAD_STATS)
+#include "thread_stats.h"
+#endif
+
+/** @brief pipeline stats: contadores e percentis de latência */
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct pipeline_counters n;
+
+	pipeline_counters_get(&n);
+	shell_print(sh, "samples %u, blocks %u, drops %u, overruns %u", n.samples, n.blocks,
+		    n.drops, n.overruns);
+
+	for (int s = 0; s < TRACE_SPANS; s++) {
+		shell_print(sh, "%-13s p50 %u p90 %u p99 %u ns", latency_trace_span_name(s),
+			    latency_trace_percentile(s, 50), latency_trace_percentile(s, 90),
+			    latency_trace_percentile(s, 99));
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_APP_THREAD_STATS)
+/** @brief pipeline threads: CPU e stack de cada thread, no log */
+static int cmd_threads(const struct shell *sh, size_t argc, char **argv)
+{
+	/* Same report as the periodic one, the CPU shares cover the time since either */
+	thread_stats_report();
+
+	return 0;
+}
+#endif
+
+/** @brief pipeline config: configuração publicada */
+static int cmd_config(const struct shell *sh, size_t argc, char **argv)
+{
+	struct pipeline_cfg cfg = { 0 };
+
+	pipeline_cfg_refresh(&cfg);
+	shell_print(sh, "period %u ms, window %u, band %u %%, pwm %u us (generation %u)",
+		    cfg.period_ms, cfg.window, cfg.band_pct, cfg.pwm_period_us, cfg.gen);
+
+	return 0;
+}
+
+/** @brief pipeline set <period|window|band|pwm> <valor>: publica uma nova configuração */
+static int cmd_set(const struct shell *sh, size_t argc, char **argv)
+{
+	struct pipeline_cfg cfg = { 0 };
+	char *end;
+	unsigned long v = strtoul(argv[1], &end, 0);
+	int err;
+
+	if (*argv[1] == '\0' || *end != '\0' || v > UINT32_MAX) {
+		shell_error(sh, "invalid value: %s", argv[1]);
+		return -EINVAL;
+	}
+
+	/* Read-modify-write of the published snapshot; writers are serialized in pipeline_cfg_set() */
+	pipeline_cfg_refresh(&cfg);
+	if (strcmp(argv[0], "period") == 0) {
+		cfg.period_ms = v;
+	} else if (strcmp(argv[0], "window") == 0) {
+		cfg.window = MIN(v, UINT16_MAX);
+	} else if (strcmp(argv[0], "band") == 0) {
+		cfg.band_pct = MIN(v, UINT16_MAX);
+	} else {
+		cfg.pwm_period_us = v;
+	}
+
+	err = pipeline_cfg_set(&cfg);
+	if (err == -EINVAL) {
+		shell_error(sh, "%s out of range", argv[0]);
+	} else if (err == -ENOTSUP) {
+		shell_error(sh, "%s is fixed in this build", argv[0]);
+	} else if (err) {
+		shell_error(sh, "pipeline_cfg_set() failed with error code %d", err);
+	}
+
+	return err;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_pipeline_set,
+	SHELL_CMD_ARG(period, NULL, "ADC sampling period (ms)", cmd_set, 2, 0),
+	SHELL_CMD_ARG(window, NULL, "Filter window (samples, up to APP_FILTER_WINDOW)", cmd_set, 2, 0),
+	SHELL_CMD_ARG(band, NULL, "Trimmed mean band (% of the mean)", cmd_set, 2, 0),
+	SHELL_CMD_ARG(pwm, NULL, "PWM period (us)", cmd_set, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_pipeline,
+	SHELL_CMD(stats, NULL, "Samples, drops, overruns and latency percentiles", cmd_stats),
+	SHELL_CMD(config, NULL, "Current period, window, band and PWM period", cmd_config),
+#if defined(CONFIG_APP_THREAD_STATS)
+	SHELL_CMD(threads, NULL, "CPU share and stack high-water of each thread (to the log)",
+		  cmd_threads),
+#endif
+	SHELL_CMD(set, &sub_pipeline_set, "Change a parameter at runtime", NULL),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(pipeline, &sub_pipeline, "ADC -> filter -> PWM pipeline", NULL);
@@ -0,0 +1,52 @@
+/*
+ * Saída PWM do pipeline no PWM da placa
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <devicetree.h>
+#include <drivers/pwm.h>
+#include <logging/log.h>
+
+#include "adc_acq.h"
+#include "pwm_out.h"
+
+LOG_MODULE_REGISTER(pwm_out, CONFIG_APP_LOG_LEVEL);
+
+#define PWM0_NID DT_NODELABEL(pwm0) /**< Node label do PWM */
+#define BOARDLED_PIN 0x0e /**< Endereço do led da placa a ser usado */
+
+/* PWM pin driven by each ADC channel, from the pwm-pins of the zephyr,user node */
+#if DT_NODE_HAS_PROP(ADC_USER_NID, pwm_pins)
+static const uint32_t pwm_pins[] = DT_PROP(ADC_USER_NID, pwm_pins); /**< Pino PWM (LED) de cada canal da ADC */
+#else
+static const uint32_t pwm_pins[] = { BOARDLED_PIN }; /**< Pino PWM (LED) de cada canal da ADC */
+#endif
+BUILD_ASSERT(ARRAY_SIZE(pwm_pins) == ADC_NUM_CHANNELS, "pwm-pins must list one pin per ADC channel");
+
+static const struct device *pwm0_dev; /**< PWM, NULL se o duty-cycle só for impresso */
+
+void pwm_out_init(void)
+{
+#if DT_NODE_HAS_STATUS(PWM0_NID, okay)
+	pwm0_dev = device_get_binding(DT_LABEL(PWM0_NID));
+	if (pwm0_dev == NULL) {
+		/* Keep draining pwm_link, otherwise thread_FILTRO ends up dropping every block */
+		LOG_ERR("Failed to bind to PWM0, the duty-cycle is only logged");
+	} else {
+		LOG_INF("Bind to PWM0 successfull");
+	}
+#else
+	/* No PWM on this board and APP_PWM_STUB disabled: the duty-cycle is only logged */
+	pwm0_dev = NULL;
+#endif
+}
+
+void pwm_out_set(int c, uint32_t period_us, uint32_t pulse_us)
+{
+	if (pwm0_dev != NULL) {
+		pwm_pin_set_usec(pwm0_dev, pwm_pins[c], period_us, pulse_us, PWM_POLARITY_NORMAL);
+	} else {
+		LOG_INF("PWM DC value AN%u: %u %%", adc_channel_inputs[c], pulse_us);
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * PWM simulado: regista cada atualização do duty-cycle
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+
+#include "adc_acq.h"
+#include "cycles.h"
+#include "pwm_out.h"
+#include "pwm_stub.h"
+
+LOG_MODULE_REGISTER(pwm_stub, CONFIG_APP_LOG_LEVEL);
+
+#define RING_SIZE CONFIG_APP_PWM_STUB_RING_SIZE
+
+BUILD_ASSERT((RING_SIZE & (RING_SIZE - 1)) == 0, "APP_PWM_STUB_RING_SIZE must be a power of 2");
+
+static struct pwm_stub_event ring[RING_SIZE];
+static uint32_t head; /* Updates ever recorded, the next one goes to ring[head % RING_SIZE] */
+
+static pwm_stub_callback_t callback;
+static void *callback_data;
+
+void pwm_out_init(void)
+{
+	LOG_INF("PWM stub: duty-cycle updates are recorded, not output");
+}
+
+void pwm_out_set(int c, uint32_t period_us, uint32_t pulse_us)
+{
+	struct pwm_stub_event *e = &ring[head & (RING_SIZE - 1)];
+
+	e->t = cycles_now();
+	e->channel = c;
+	e->period_us = period_us;
+	e->pulse_us = pulse_us;
+	head++;
+
+	LOG_DBG("PWM DC value AN%u: %u %%", adc_channel_inputs[c], pulse_us);
+
+	if (callback != NULL) {
+		callback(e, callback_data);
+	}
+}
+
+uint32_t pwm_stub_count(void)
+{
+	return head;
+}
+
+int pwm_stub_last(struct pwm_stub_event *out, int n)
+{
+	uint32_t end = head;
+	uint32_t count = MIN(MIN(end, (uint32_t)RING_SIZE), (uint32_t)n);
+
+	for (uint32_t i = 0; i < count; i++) {
+		out[i] = ring[(end - count + i) & (RING_SIZE - 1)];
+	}
+	return count;
+}
+
+void pwm_stub_set_callback(pwm_stub_callback_t cb, void *user_data)
+{
+	callback_data = user_data;
+	callback = cb;
+}
@@ -0,0 +1,264 @@
+/*
+ * Reprodução de gravações da entrada analógica através do pipeline (native_posix)
+ */
+
+#include <zephyr.h>
+#include <init.h>
+#include <logging/log.h>
+#include <logging/log_ctrl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* native_posix: command line, host clock and exit */
+#include "cmdline.h"
+#include "native_rtc.h"
+#include "posix_board_if.h"
+#include "soc.h"
+
+#include "adc_acq.h"
+#include "adc_wave.h"
+#include "pwm_stub.h"
+#include "replay.h"
+
+LOG_MODULE_REGISTER(replay, CONFIG_APP_LOG_LEVEL);
+
+#define REPLAY_LINE_MAX 256 /* Longest input line */
+#define REPLAY_TIMEOUT K_SECONDS(1) /* A block that never reaches the PWM (dropped) */
+
+static char *in_path; /* --replay-in */
+static char *out_path; /* --replay-out */
+static char *golden_path; /* --replay-golden */
+
+static uint16_t *scans[ADC_NUM_CHANNELS]; /* Recording, one array per channel (host heap) */
+static uint32_t scan_count; /* Scans in the recording */
+static uint32_t scans_sent; /* Scans acquired by thread_ADC */
+static uint32_t blocks_lost; /* Blocks that did not reach the PWM before REPLAY_TIMEOUT */
+static FILE *out; /* Duty-cycle stream */
+static uint64_t t_start_us; /* Host time of replay_start() */
+
+static K_SEM_DEFINE(block_done, 0, 1); /* Given by the PWM stage after the last channel of a block */
+
+static void replay_options(void)
+{
+	static struct args_struct_t options[] = {
+		{ .option = "replay-in", .name = "file", .type = 's', .dest = (void *)&in_path,
+		  .descript = "Recorded input: one scan per line, a mV value per ADC channel" },
+		{ .option = "replay-out", .name = "file", .type = 's', .dest = (void *)&out_path,
+		  .descript = "Duty-cycle stream: one line per block, a value per channel" },
+		{ .option = "replay-golden", .name = "file", .type = 's', .dest = (void *)&golden_path,
+		  .descript = "Expected duty-cycle stream, compared with the output at the end" },
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(options);
+}
+NATIVE_TASK(replay_options, PRE_BOOT_1, 1);
+
+/** @brief Lê a gravação para scans[]; devolve o número de varrimentos, ou -1 */
+static int load(const char *path)
+{
+	char line[REPLAY_LINE_MAX];
+	uint32_t cap = 0;
+	uint32_t n = 0;
+	uint32_t lineno = 0;
+	FILE *f = fopen(path, "r");
+
+	if (f == NULL) {
+		LOG_ERR("cannot open %s", log_strdup(path));
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), f) != NULL) {
+		char *p = line;
+
+		lineno++;
+		p += strspn(p, " \t\r\n");
+		if (*p == '\0' || *p == '#') {
+			continue;
+		}
+
+		if (n == cap) {
+			cap = cap ? 2 * cap : 4096;
+			for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+				scans[c] = realloc(scans[c], cap * sizeof(scans[c][0]));
+				if (scans[c] == NULL) {
+					LOG_ERR("out of memory at line %u", lineno);
+					fclose(f);
+					return -1;
+				}
+			}
+		}
+
+		for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+			char *end;
+			long v = strtol(p, &end, 10);
+
+			if (end == p || v < 0 || v > UINT16_MAX) {
+				LOG_ERR("%s:%u: expected %d value(s) in mV", log_strdup(path), lineno,
+					ADC_NUM_CHANNELS);
+				fclose(f);
+				return -1;
+			}
+			scans[c][n] = v;
+			p = end + strspn(end, " \t,");
+		}
+		n++;
+	}
+
+	fclose(f);
+	return n;
+}
+
+/** @brief Callback do PWM simulado: uma linha por bloco na saída */
+static void record(const struct pwm_stub_event *e, void *user_data)
+{
+	if (out != NULL) {
+		fprintf(out, "%u%c", e->pulse_us, e->channel == ADC_NUM_CHANNELS - 1 ? '\n' : ' ');
+	}
+	if (e->channel == ADC_NUM_CHANNELS - 1) {
+		k_sem_give(&block_done);
+	}
+}
+
+/** @brief Carrega a gravação e liga-se ao PWM simulado, antes de o pipeline arrancar */
+static int replay_init(const struct device *dev)
+{
+	int n;
+
+	if (in_path == NULL) {
+		return 0;
+	}
+
+	n = load(in_path);
+	if (n <= 0) {
+		LOG_ERR("replay: no scans in %s, running the normal acquisition", log_strdup(in_path));
+		return 0;
+	}
+	scan_count = n;
+
+	if (out_path != NULL) {
+		out = fopen(out_path, "w");
+		if (out == NULL) {
+			LOG_ERR("cannot open %s", log_strdup(out_path));
+		}
+	}
+	pwm_stub_set_callback(record, NULL);
+
+	return 0;
+}
+SYS_INIT(replay_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+bool replay_active(void)
+{
+	return scan_count > 0;
+}
+
+void replay_start(void)
+{
+	if (!replay_active()) {
+		return;
+	}
+
+	for (int c = 0; c < ADC_NUM_CHANNELS; c++) {
+		/* One value per conversion, whatever the simulated time */
+		const struct adc_wave w = {
+			.shape = ADC_WAVE_TABLE,
+			.table = scans[c],
+			.table_len = scan_count,
+		};
+		int err = adc_wave_set(c, &w);
+
+		if (err) {
+			LOG_ERR("adc_wave_set() failed with error code %d", err);
+		}
+	}
+
+	LOG_INF("replay: %u scans of %d channel(s) from %s", scan_count, ADC_NUM_CHANNELS,
+		log_strdup(in_path));
+	t_start_us = native_rtc_gettime_us(RTC_CLOCK_REALTIME);
+}
+
+/** @brief Compara a saída com --replay-golden; devolve as linhas diferentes */
+static uint32_t compare_golden(void)
+{
+	char a[REPLAY_LINE_MAX];
+	char b[REPLAY_LINE_MAX];
+	uint32_t line = 0;
+	uint32_t diffs = 0;
+	FILE *fo = fopen(out_path, "r");
+	FILE *fg = fopen(golden_path, "r");
+
+	if (fo == NULL || fg == NULL) {
+		LOG_ERR("cannot compare %s with %s", log_strdup(out_path), log_strdup(golden_path));
+		diffs = 1;
+		goto done;
+	}
+
+	for (;;) {
+		char *ra = fgets(a, sizeof(a), fo);
+		char *rb = fgets(b, sizeof(b), fg);
+
+		if (ra == NULL && rb == NULL) {
+			break;
+		}
+		line++;
+		if (ra == NULL || rb == NULL || strcmp(a, b) != 0) {
+			if (diffs++ == 0) {
+				LOG_WRN("replay: first difference at block %u", line);
+			}
+		}
+	}
+
+done:
+	if (fo != NULL) {
+		fclose(fo);
+	}
+	if (fg != NULL) {
+		fclose(fg);
+	}
+	return diffs;
+}
+
+/** @brief Relatório final e fim do processo */
+static void finish(void)
+{
+	uint64_t us = native_rtc_gettime_us(RTC_CLOCK_REALTIME) - t_start_us;
+	uint32_t diffs = 0;
+
+	if (out != NULL) {
+		fclose(out);
+		out = NULL;
+	}
+
+	LOG_INF("replay: %u scans (%u samples) in %u ms, %u samples/s, %u block(s) lost",
+		scans_sent, scans_sent * ADC_NUM_CHANNELS, (uint32_t)(us / 1000),
+		us ? (uint32_t)((uint64_t)scans_sent * ADC_NUM_CHANNELS * USEC_PER_SEC / us) : 0,
+		blocks_lost);
+
+	if (golden_path != NULL && out_path != NULL) {
+		diffs = compare_golden();
+		if (diffs) {
+			LOG_ERR("replay: %u block(s) differ from %s", diffs, log_strdup(golden_path));
+		} else {
+			LOG_INF("replay: output matches %s", log_strdup(golden_path));
+		}
+	}
+
+	/* Deferred logging: flush everything before leaving */
+	LOG_PANIC();
+	posix_exit(diffs || blocks_lost ? 1 : 0);
+}
+
+void replay_next(void)
+{
+	/* The scan just sent goes through FILTRO and PWM before the next one: nothing is dropped */
+	scans_sent++;
+	if (k_sem_take(&block_done, REPLAY_TIMEOUT) != 0) {
+		blocks_lost++;
+	}
+
+	if (scans_sent >= scan_count) {
+		finish();
+	}
+}
@@ -0,0 +1,125 @@
+/*
+ * Prioridades deadline-monotonic e análise do tempo de resposta das etapas
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+
+#include "sched_rta.h"
+
+LOG_MODULE_REGISTER(sched_rta, CONFIG_APP_LOG_LEVEL);
+
+/** @brief WCET medido em us, arredondado por excesso */
+static uint32_t wcet_us(const struct rta_task *t)
+{
+	return (uint32_t)((cycles_to_ns(t->wcet) + NSEC_PER_USEC - 1) / NSEC_PER_USEC);
+}
+
+void rta_assign_dm(struct rta_task *t, int n, int base_prio)
+{
+	int prio = base_prio;
+	uint32_t done = 0; /* bit i: task i already has its priority */
+
+	for (int i = 0; i < n; i++) {
+		if (t[i].prio == RTA_PRIO_ISR) {
+			done |= BIT(i);
+		}
+	}
+
+	/* Selection by increasing deadline, ties keep the pipeline order */
+	for (int k = 0; k < n; k++) {
+		int best = -1;
+
+		for (int i = 0; i < n; i++) {
+			if (!(done & BIT(i)) && (best < 0 || t[i].deadline_us < t[best].deadline_us)) {
+				best = i;
+			}
+		}
+		if (best < 0) {
+			break;
+		}
+		t[best].prio = prio++;
+		done |= BIT(best);
+	}
+}
+
+uint32_t rta_report(const struct rta_task *t, int n)
+{
+	uint64_t e2e = 0;
+	bool ok = true;
+
+	LOG_INF("response-time analysis (fixed priorities, measured WCET)");
+	LOG_INF("%-10s %6s %10s %10s %10s %10s", "stage", "prio", "C us", "T us", "D us", "R us");
+
+	for (int i = 0; i < n; i++) {
+		uint64_t c = wcet_us(&t[i]);
+		uint64_t r = c;
+		uint64_t prev;
+
+		/* Critical instant: every higher or equal priority task released together */
+		for (int j = 0; j < n; j++) {
+			if (j != i && t[j].prio <= t[i].prio) {
+				r += wcet_us(&t[j]);
+			}
+		}
+
+		/* R = C + sum over higher or equal priority tasks of ceil(R / Tj) * Cj */
+		do {
+			prev = r;
+			r = c;
+			for (int j = 0; j < n; j++) {
+				if (j != i && t[j].prio <= t[i].prio) {
+					r += DIV_ROUND_UP(prev, t[j].period_us) * wcet_us(&t[j]);
+				}
+			}
+		} while (r != prev && r <= t[i].deadline_us);
+
+		/* One message per row: deferred logging does not join partial lines */
+		if (t[i].prio == RTA_PRIO_ISR) {
+			LOG_INF("%-10s %6s %10u %10u %10u %10u%s", t[i].name, "isr", (uint32_t)c,
+				t[i].period_us, t[i].deadline_us, (uint32_t)r,
+				r > t[i].deadline_us ? " MISS" : "");
+		} else {
+			LOG_INF("%-10s %6d %10u %10u %10u %10u%s", t[i].name, t[i].prio, (uint32_t)c,
+				t[i].period_us, t[i].deadline_us, (uint32_t)r,
+				r > t[i].deadline_us ? " MISS" : "");
+		}
+
+		ok = ok && r <= t[i].deadline_us;
+		e2e += r;
+	}
+
+	if (!ok) {
+		LOG_WRN("end-to-end: no bound, a stage can miss its deadline");
+		return 0;
+	}
+	LOG_INF("end-to-end bound (sum of R): %u us", (uint32_t)e2e);
+	return (uint32_t)e2e;
+}
+
+uint32_t rta_report_edf(const struct rta_task *t, int n)
+{
+	uint64_t util = 0;	/* per mille */
+	uint64_t density = 0;	/* per mille */
+	uint64_t e2e = 0;
+
+	LOG_INF("EDF schedulability (measured WCET)");
+	LOG_INF("%-10s %10s %10s %10s", "stage", "C us", "T us", "D us");
+
+	for (int i = 0; i < n; i++) {
+		uint32_t c = wcet_us(&t[i]);
+
+		LOG_INF("%-10s %10u %10u %10u", t[i].name, c, t[i].period_us, t[i].deadline_us);
+		util += (uint64_t)c * 1000 / t[i].period_us;
+		density += (uint64_t)c * 1000 / MIN(t[i].deadline_us, t[i].period_us);
+		e2e += t[i].deadline_us;
+	}
+
+	LOG_INF("utilization %u/1000, density %u/1000", (uint32_t)util, (uint32_t)density);
+	if (density > 1000) {
+		LOG_WRN("end-to-end: no bound, density above 1");
+		return 0;
+	}
+	LOG_INF("end-to-end bound (sum of D): %u us", (uint32_t)e2e);
+	return (uint32_t)e2e;
+}
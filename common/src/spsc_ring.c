@@ -0,0 +1,95 @@
+/*
+ * Anel sem locks para um produtor e um consumidor
+ */
+
+#include <zephyr.h>
+#include <string.h>
+
+#include "spsc_ring.h"
+
+int spsc_ring_init(struct spsc_ring *r, void *buf, size_t elem_size, uint32_t capacity,
+		   struct k_sem *wake)
+{
+	if (capacity == 0 || (capacity & (capacity - 1))) {
+		return -EINVAL;
+	}
+
+	r->buf = buf;
+	r->elem_size = elem_size;
+	r->mask = capacity - 1;
+	atomic_set(&r->head, 0);
+	atomic_set(&r->tail, 0);
+	r->wake = wake;
+
+	return 0;
+}
+
+/** @brief Copia n elementos entre data e o anel a partir do contador pos, dando a volta se preciso */
+static void spsc_ring_copy(struct spsc_ring *r, uint32_t pos, void *data, uint32_t n, bool to_ring)
+{
+	uint32_t idx = pos & r->mask;
+	uint32_t first = MIN(n, r->mask + 1 - idx);
+	uint8_t *slot = r->buf + idx * r->elem_size;
+	uint8_t *ext = data;
+
+	if (to_ring) {
+		memcpy(slot, ext, first * r->elem_size);
+		memcpy(r->buf, ext + first * r->elem_size, (n - first) * r->elem_size);
+	} else {
+		memcpy(ext, slot, first * r->elem_size);
+		memcpy(ext + first * r->elem_size, r->buf, (n - first) * r->elem_size);
+	}
+}
+
+uint32_t spsc_ring_put(struct spsc_ring *r, const void *data, uint32_t n)
+{
+	uint32_t tail = atomic_get(&r->tail);
+	uint32_t head = atomic_get(&r->head);
+
+	if (r->mask + 1 - (tail - head) < n) {
+		return 0;
+	}
+
+	spsc_ring_copy(r, tail, (void *)data, n, true);
+
+	/* Publish after the copy: atomic_set() is a full barrier */
+	atomic_set(&r->tail, tail + n);
+
+	/* Only the empty -> non-empty transition needs a wakeup; head is re-read,
+	 * the consumer may have drained the ring while we were copying
+	 */
+	if (r->wake != NULL && n > 0 && (uint32_t)atomic_get(&r->head) == tail) {
+		k_sem_give(r->wake);
+	}
+
+	return n;
+}
+
+uint32_t spsc_ring_get(struct spsc_ring *r, void *data, uint32_t max)
+{
+	uint32_t head = atomic_get(&r->head);
+	uint32_t n = MIN(max, (uint32_t)atomic_get(&r->tail) - head);
+
+	if (n == 0) {
+		return 0;
+	}
+
+	spsc_ring_copy(r, head, data, n, false);
+
+	/* Release the slots only once they have been copied out */
+	atomic_set(&r->head, head + n);
+
+	return n;
+}
+
+int spsc_ring_wait(struct spsc_ring *r, k_timeout_t timeout)
+{
+	/* A stale give can wake us on an empty ring, so check again after every wakeup */
+	while (spsc_ring_count(r) == 0) {
+		if (r->wake == NULL || k_sem_take(r->wake, timeout)) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * Tempo de CPU e ocupação máxima da stack de cada thread
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+
+#include "thread_stats.h"
+
+LOG_MODULE_REGISTER(thread_stats, CONFIG_APP_LOG_LEVEL);
+
+#define THREAD_STATS_MAX 16 /* Threads followed; pipeline, main, idle, logging and a few spare */
+
+/** @brief Ciclos de execução acumulados de uma thread num dado instante */
+struct thread_sample {
+	const struct k_thread *thread;
+	uint64_t cycles;
+};
+
+/** @brief Todas as threads num dado instante */
+struct thread_snapshot {
+	struct thread_sample s[THREAD_STATS_MAX];
+	int count;
+	int missed; /* Threads beyond THREAD_STATS_MAX */
+};
+
+static struct thread_snapshot prev; /* Snapshot of the previous report */
+
+/* The periodic report and the shell may ask at the same time, both update prev */
+K_MUTEX_DEFINE(report_lock);
+
+/* Called with the thread list locked: only reads the counters */
+static void collect(const struct k_thread *thread, void *user_data)
+{
+	struct thread_snapshot *snap = user_data;
+	k_thread_runtime_stats_t rt;
+
+	if (snap->count == THREAD_STATS_MAX) {
+		snap->missed++;
+		return;
+	}
+	if (k_thread_runtime_stats_get((k_tid_t)thread, &rt) != 0) {
+		rt.execution_cycles = 0;
+	}
+	snap->s[snap->count].thread = thread;
+	snap->s[snap->count].cycles = rt.execution_cycles;
+	snap->count++;
+}
+
+/** @brief Ciclos da thread no relatório anterior, 0 se ainda não existia */
+static uint64_t prev_cycles(const struct k_thread *thread)
+{
+	for (int i = 0; i < prev.count; i++) {
+		if (prev.s[i].thread == thread) {
+			return prev.s[i].cycles;
+		}
+	}
+	return 0;
+}
+
+void thread_stats_report(void)
+{
+	static struct thread_snapshot snap;
+	uint64_t delta[THREAD_STATS_MAX];
+	uint64_t total = 0;
+	uint32_t idle = 0;
+
+	k_mutex_lock(&report_lock, K_FOREVER);
+	snap.count = 0;
+	snap.missed = 0;
+	k_thread_foreach(collect, &snap);
+
+	/* Every thread, idle included, is accounted: the sum is the length of the window */
+	for (int i = 0; i < snap.count; i++) {
+		delta[i] = snap.s[i].cycles - prev_cycles(snap.s[i].thread);
+		total += delta[i];
+	}
+
+	for (int i = 0; i < snap.count; i++) {
+		k_tid_t tid = (k_tid_t)snap.s[i].thread;
+		const char *name = k_thread_name_get(tid);
+		size_t size = tid->stack_info.size;
+		size_t unused = size;
+		uint32_t share = total ? (uint32_t)(delta[i] * 10000 / total) : 0; /* 0.01 % */
+
+		/* Scans the stack for the first overwritten fill byte (CONFIG_INIT_STACKS) */
+		if (k_thread_stack_space_get(tid, &unused) != 0) {
+			unused = size;
+		}
+
+		if (k_thread_priority_get(tid) == K_IDLE_PRIO) {
+			idle += share;
+		}
+		LOG_INF("%-20s cpu %3u.%02u %%, stack %4u / %4u B", log_strdup(name ? name : "?"),
+			share / 100, share % 100, (uint32_t)(size - unused), (uint32_t)size);
+	}
+
+	LOG_INF("idle %u.%02u %%", idle / 100, idle % 100);
+	if (snap.missed) {
+		LOG_WRN("%d thread(s) beyond THREAD_STATS_MAX not shown", snap.missed);
+	}
+
+	prev = snap;
+	k_mutex_unlock(&report_lock);
+}
@@ -0,0 +1,16 @@
+/*
+ * Contadores comuns a todos os transportes
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+
+#include "transport.h"
+
+LOG_MODULE_REGISTER(transport, CONFIG_APP_LOG_LEVEL);
+
+void transport_report(const struct transport_stats *s, const char *name)
+{
+	LOG_INF("%s: %u dropped, %u coalesced, high-water %u",
+		name, s->dropped, s->coalesced, s->high_water);
+}
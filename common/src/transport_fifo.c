@@ -0,0 +1,153 @@
+/*
+ * Transporte por k_fifo limitado, com blocos de um k_mem_slab
+ */
+
+#include <zephyr.h>
+
+#include "cycles.h"
+#include "transport.h"
+
+int transport_fifo_init(struct transport_fifo *t)
+{
+	k_fifo_init(&t->fifo);
+	k_sem_init(&t->items, 0, K_SEM_MAX_LIMIT);
+	t->depth = 0;
+	t->pending = NULL;
+	k_sem_init(&t->space, CONFIG_APP_TRANSPORT_DEPTH, CONFIG_APP_TRANSPORT_DEPTH);
+	t->stats = (struct transport_stats){ 0 };
+
+	return k_mem_slab_init(&t->slab, t->mem, sizeof(t->mem[0]), ARRAY_SIZE(t->mem));
+}
+
+/** @brief Põe um bloco na fila e atualiza a ocupação máxima (com t->lock tomado)
+ *
+ * Nenhuma thread espera no k_fifo, por isso o k_fifo_put() não muda de
+ * contexto; quem chama dá t->items depois de largar o lock.
+ */
+static void transport_fifo_put(struct transport_fifo *t, struct transport_fifo_item *item)
+{
+	k_fifo_put(&t->fifo, item);
+	if (++t->depth > t->stats.high_water) {
+		t->stats.high_water = t->depth;
+	}
+}
+
+struct sample_block *transport_fifo_alloc(struct transport_fifo *t)
+{
+	void *item;
+
+#if defined(CONFIG_APP_TRANSPORT_OVERLOAD_BLOCK)
+	/* Back-pressure: the producer waits for the consumer to free a place */
+	k_sem_take(&t->space, K_FOREVER);
+#endif
+
+	/* The pool is sized for a full queue, running out means blocks are leaking */
+	if (k_mem_slab_alloc(&t->slab, &item, K_NO_WAIT)) {
+#if defined(CONFIG_APP_TRANSPORT_OVERLOAD_BLOCK)
+		k_sem_give(&t->space);
+#endif
+		t->stats.dropped++;
+		return NULL;
+	}
+
+	return &CONTAINER_OF(item, struct transport_fifo_item, fifo_reserved)->block;
+}
+
+int transport_fifo_send(struct transport_fifo *t, struct sample_block *b)
+{
+	struct transport_fifo_item *item = CONTAINER_OF(b, struct transport_fifo_item, block);
+	void *old = NULL;
+	k_spinlock_key_t key;
+
+	b->stamp = cycles_now();
+
+	key = k_spin_lock(&t->lock);
+#if !defined(CONFIG_APP_TRANSPORT_OVERLOAD_BLOCK)
+	if (t->depth >= CONFIG_APP_TRANSPORT_DEPTH) {
+#if defined(CONFIG_APP_TRANSPORT_OVERLOAD_DROP_OLDEST)
+		/* Checked and evicted under the lock: the consumer cannot empty the queue in between */
+		old = k_fifo_get(&t->fifo, K_NO_WAIT);
+		t->depth--;
+		t->stats.dropped++;
+		/* Its wakeup goes with it, unless the consumer already took it (recv checks again) */
+		k_sem_take(&t->items, K_NO_WAIT);
+#elif defined(CONFIG_APP_TRANSPORT_OVERLOAD_COALESCE)
+		/* The newest block waits outside the queue, replacing any block already waiting */
+		old = t->pending;
+		t->pending = item;
+		if (old != NULL) {
+			t->stats.coalesced++;
+		}
+		k_spin_unlock(&t->lock, key);
+
+		if (old != NULL) {
+			k_mem_slab_free(&t->slab, &old);
+		}
+		return 0;
+#else
+		t->stats.dropped++;
+		k_spin_unlock(&t->lock, key);
+
+		old = item;
+		k_mem_slab_free(&t->slab, &old);
+		return -ENOBUFS;
+#endif
+	}
+#endif
+
+	/* No copy: the fifo links the block through its reserved word */
+	transport_fifo_put(t, item);
+	k_spin_unlock(&t->lock, key);
+
+	k_sem_give(&t->items);
+	if (old != NULL) {
+		k_mem_slab_free(&t->slab, &old);
+	}
+
+	return 0;
+}
+
+struct sample_block *transport_fifo_recv(struct transport_fifo *t, k_timeout_t timeout)
+{
+	struct transport_fifo_item *item;
+	bool flushed = false;
+	k_spinlock_key_t key;
+
+	/* A block evicted after its give was taken leaves the queue empty, so wait again */
+	do {
+		if (k_sem_take(&t->items, timeout)) {
+			return NULL;
+		}
+
+		key = k_spin_lock(&t->lock);
+		item = k_fifo_get(&t->fifo, K_NO_WAIT);
+		if (item != NULL) {
+			t->depth--;
+#if defined(CONFIG_APP_TRANSPORT_OVERLOAD_COALESCE)
+			/* The pending block takes the place just freed */
+			if (t->pending != NULL) {
+				transport_fifo_put(t, t->pending);
+				t->pending = NULL;
+				flushed = true;
+			}
+#endif
+		}
+		k_spin_unlock(&t->lock, key);
+	} while (item == NULL);
+
+#if defined(CONFIG_APP_TRANSPORT_OVERLOAD_BLOCK)
+	k_sem_give(&t->space);
+#endif
+	if (flushed) {
+		k_sem_give(&t->items);
+	}
+
+	return &item->block;
+}
+
+void transport_fifo_release(struct transport_fifo *t, struct sample_block *b)
+{
+	void *item = CONTAINER_OF(b, struct transport_fifo_item, block);
+
+	k_mem_slab_free(&t->slab, &item);
+}
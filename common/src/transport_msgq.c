@@ -0,0 +1,54 @@
+/*
+ * Transporte por k_msgq
+ */
+
+#include <zephyr.h>
+
+#include "cycles.h"
+#include "transport.h"
+
+int transport_msgq_init(struct transport_msgq *t)
+{
+	k_msgq_init(&t->msgq, t->mem, sizeof(struct sample_block), CONFIG_APP_TRANSPORT_DEPTH);
+	t->stats = (struct transport_stats){ 0 };
+
+	return 0;
+}
+
+struct sample_block *transport_msgq_alloc(struct transport_msgq *t)
+{
+	/* Filled in place and copied into the queue by the send */
+	return &t->in;
+}
+
+int transport_msgq_send(struct transport_msgq *t, struct sample_block *b)
+{
+	uint32_t used;
+
+	b->stamp = cycles_now();
+
+	if (k_msgq_put(&t->msgq, b, K_NO_WAIT)) {
+		t->stats.dropped++;
+		return -ENOMSG;
+	}
+
+	used = k_msgq_num_used_get(&t->msgq);
+	if (used > t->stats.high_water) {
+		t->stats.high_water = used;
+	}
+
+	return 0;
+}
+
+struct sample_block *transport_msgq_recv(struct transport_msgq *t, k_timeout_t timeout)
+{
+	if (k_msgq_get(&t->msgq, &t->out, timeout)) {
+		return NULL;
+	}
+
+	return &t->out;
+}
+
+void transport_msgq_release(struct transport_msgq *t, struct sample_block *b)
+{
+}
@@ -0,0 +1,56 @@
+/*
+ * Transporte por k_poll_signal e variável partilhada
+ */
+
+#include <zephyr.h>
+
+#include "cycles.h"
+#include "transport.h"
+
+int transport_poll_init(struct transport_poll *t)
+{
+	t->shared.count = 0;
+	t->stats = (struct transport_stats){ .high_water = 1 };
+	k_poll_signal_init(&t->signal);
+	k_poll_event_init(&t->event, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &t->signal);
+
+	return 0;
+}
+
+struct sample_block *transport_poll_alloc(struct transport_poll *t)
+{
+	/* Always the shared block, even if the consumer has not read it yet */
+	return &t->shared;
+}
+
+int transport_poll_send(struct transport_poll *t, struct sample_block *b)
+{
+	unsigned int signaled;
+	int result;
+
+	b->stamp = cycles_now();
+	/* Still raised: the consumer never saw the block this one replaces */
+	k_poll_signal_check(&t->signal, &signaled, &result);
+	if (signaled) {
+		t->stats.coalesced++;
+	}
+
+	return k_poll_signal_raise(&t->signal, 0);
+}
+
+struct sample_block *transport_poll_recv(struct transport_poll *t, k_timeout_t timeout)
+{
+	if (k_poll(&t->event, 1, timeout)) {
+		return NULL;
+	}
+
+	/* Reset before reading: a block sent from here on raises the signal again */
+	t->event.state = K_POLL_STATE_NOT_READY;
+	k_poll_signal_reset(&t->signal);
+
+	return &t->shared;
+}
+
+void transport_poll_release(struct transport_poll *t, struct sample_block *b)
+{
+}
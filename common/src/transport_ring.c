@@ -0,0 +1,104 @@
+/*
+ * Transporte por anel SPSC sem locks
+ */
+
+#include <zephyr.h>
+
+#include "cycles.h"
+#include "transport.h"
+
+BUILD_ASSERT((CONFIG_APP_TRANSPORT_RING_SCANS & (CONFIG_APP_TRANSPORT_RING_SCANS - 1)) == 0,
+	     "APP_TRANSPORT_RING_SCANS must be a power of 2");
+BUILD_ASSERT(CONFIG_APP_TRANSPORT_RING_SCANS >= ADC_BURST_SAMPLES,
+	     "APP_TRANSPORT_RING_SCANS must hold at least one burst");
+
+int transport_ring_init(struct transport_ring *t)
+{
+	k_sem_init(&t->wake, 0, 1);
+	atomic_set(&t->hdr_tail, 0);
+	atomic_set(&t->hdr_head, 0);
+	t->written = 0;
+	t->read = 0;
+	t->stats = (struct transport_stats){ 0 };
+
+	return spsc_ring_init(&t->ring, t->mem, sizeof(t->mem[0]), ARRAY_SIZE(t->mem), &t->wake);
+}
+
+struct sample_block *transport_ring_alloc(struct transport_ring *t)
+{
+	/* Filled in place and copied into the ring by the send */
+	return &t->in;
+}
+
+int transport_ring_send(struct transport_ring *t, struct sample_block *b)
+{
+	uint32_t tail = atomic_get(&t->hdr_tail);
+	struct transport_ring_hdr *h = &t->hdr[tail & (ARRAY_SIZE(t->hdr) - 1)];
+	uint32_t used;
+
+	if (b->count == 0) {
+		return 0;
+	}
+
+	/* Only the consumer frees space, so once this passes the put cannot fail */
+	if (ARRAY_SIZE(t->mem) - spsc_ring_count(&t->ring) < b->count ||
+	    tail - (uint32_t)atomic_get(&t->hdr_head) >= ARRAY_SIZE(t->hdr)) {
+		t->stats.dropped++;
+		return -ENOBUFS;
+	}
+
+	/* Publish the header before the scans: a consumer that sees them also sees it */
+	t->written += b->count;
+	h->end = t->written;
+	h->t_adc = b->t_adc;
+	h->t_filter_in = b->t_filter_in;
+	h->t_filter_out = b->t_filter_out;
+	h->stamp = cycles_now();
+	atomic_set(&t->hdr_tail, tail + 1);
+
+	spsc_ring_put(&t->ring, b->data, b->count);
+
+	used = spsc_ring_count(&t->ring);
+	if (used > t->stats.high_water) {
+		t->stats.high_water = used;
+	}
+
+	return 0;
+}
+
+struct sample_block *transport_ring_recv(struct transport_ring *t, k_timeout_t timeout)
+{
+	uint32_t head = atomic_get(&t->hdr_head);
+	struct transport_ring_hdr *h;
+
+	if (spsc_ring_wait(&t->ring, timeout)) {
+		return NULL;
+	}
+
+	/* Times of the block holding the oldest scan, i.e. the worst case */
+	h = &t->hdr[head & (ARRAY_SIZE(t->hdr) - 1)];
+	t->out.t_adc = h->t_adc;
+	t->out.t_filter_in = h->t_filter_in;
+	t->out.t_filter_out = h->t_filter_out;
+	t->out.stamp = h->stamp;
+
+	/* Batched dequeue: everything queued since the last wakeup, up to a block */
+	t->out.count = spsc_ring_get(&t->ring, t->out.data, ADC_BURST_SAMPLES);
+
+	/* Release the headers of blocks now fully read */
+	t->read += t->out.count;
+	while (head != (uint32_t)atomic_get(&t->hdr_tail)) {
+		h = &t->hdr[head & (ARRAY_SIZE(t->hdr) - 1)];
+		if ((int32_t)(h->end - t->read) > 0) {
+			break;
+		}
+		head++;
+	}
+	atomic_set(&t->hdr_head, head);
+
+	return &t->out;
+}
+
+void transport_ring_release(struct transport_ring *t, struct sample_block *b)
+{
+}
@@ -0,0 +1,72 @@
+/*
+ * Transporte por k_sem e variável partilhada com gerações
+ */
+
+#include <zephyr.h>
+#include <string.h>
+
+#include "cycles.h"
+#include "transport.h"
+
+int transport_sem_init(struct transport_sem *t)
+{
+	atomic_set(&t->seq, 0);
+	t->buf[0].count = 0;
+	t->last = 0;
+	t->retries = 0;
+	t->stats = (struct transport_stats){ .high_water = 1 };
+
+	return k_sem_init(&t->sem, 0, 1);
+}
+
+struct sample_block *transport_sem_alloc(struct transport_sem *t)
+{
+	/* Odd: generation g + 1 is being written into the buffer the consumer is not meant to read */
+	uint32_t seq = atomic_inc(&t->seq);
+
+	return &t->buf[(seq / 2 + 1) & 1];
+}
+
+int transport_sem_send(struct transport_sem *t, struct sample_block *b)
+{
+	b->stamp = cycles_now();
+	/* Even again: the new generation is published */
+	atomic_inc(&t->seq);
+	/* Saturates at 1: a generation the consumer did not take yet is skipped and counted */
+	k_sem_give(&t->sem);
+
+	return 0;
+}
+
+struct sample_block *transport_sem_recv(struct transport_sem *t, k_timeout_t timeout)
+{
+	uint32_t seq;
+	uint32_t gen;
+
+	do {
+		if (k_sem_take(&t->sem, timeout)) {
+			return NULL;
+		}
+
+		for (;;) {
+			seq = atomic_get(&t->seq);
+			gen = seq / 2;
+			memcpy(&t->out, &t->buf[gen & 1], sizeof(t->out));
+			/* buf[gen & 1] is only reused once generation gen + 2 starts, at seq 2 * gen + 3 */
+			if ((uint32_t)atomic_get(&t->seq) - 2 * gen < 3) {
+				break;
+			}
+			t->retries++;
+		}
+		/* A stale give for a generation already read: wait for the next one */
+	} while (gen == t->last);
+
+	t->stats.coalesced += gen - t->last - 1;
+	t->last = gen;
+
+	return &t->out;
+}
+
+void transport_sem_release(struct transport_sem *t, struct sample_block *b)
+{
+}
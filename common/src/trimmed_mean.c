@@ -0,0 +1,39 @@
+/*
+ * Média com rejeição das amostras afastadas da média mais do que uma banda (10% por omissão)
+ */
+
+#include <zephyr.h>
+#include <string.h>
+
+#include "trimmed_mean.h"
+
+void trimmed_mean_init(struct trimmed_mean *f, uint16_t *buf, uint16_t size)
+{
+	f->window = buf;
+	f->size = size;
+	f->idx = 0;
+	f->sum = 0;
+	f->band_pct = TRIMMED_MEAN_BAND_PCT;
+	memset(buf, 0, size * sizeof(buf[0]));
+}
+
+uint16_t trimmed_mean_output(const struct trimmed_mean *f)
+{
+	uint32_t mean = f->sum / f->size;
+	/* The mean is non-negative, so media*0.1 truncated is exactly mean*10/100 */
+	uint32_t dev = mean * f->band_pct / 100;
+	uint32_t lo = mean - dev;
+	uint32_t span = 2 * dev;
+	uint32_t sum = 0;
+	uint32_t n = 0;
+
+	for (int i = 0; i < f->size; i++) {
+		/* lo <= x <= lo + span as a single unsigned compare */
+		if ((uint32_t)(f->window[i] - lo) <= span) {
+			sum += f->window[i];
+			n++;
+		}
+	}
+
+	return n ? sum / n : 0;
+}